@@ -0,0 +1,518 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_AHOCORASICK_EXTRACTOR_HPP
+#define CONCEPT_AHOCORASICK_EXTRACTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "ConceptExtractor.hpp"
+#include "core/Bits.hpp"
+#include "core/FlatHashTable.hpp"
+#include "core/String.hpp"
+#include "core/Vector.hpp"
+#include "core/View.hpp"
+#include "Match.hpp"
+#include "Normalizer.hpp"
+#include "Words.hpp"
+
+namespace Concept {
+
+  /**
+  * Concept extractor running a word-level Aho-Corasick automaton.
+  * Dictionary words are interned with dense word IDs, and the automaton transitions on word IDs,
+  * so that one input word costs one vocabulary lookup and one transition on average.
+  *
+  * Concepts are inserted in a trie, whose transitions are kept in a Hash table keyed by (state, word ID).
+  * Before the first extraction, the trie is compiled to a double array of cells:
+  * the child of state s on word c is the cell base[s] + c, provided that check[base[s] + c] is s.
+  * Cells also hold the failure link, the concept ending at the state, and the output link,
+  * i.e. the nearest state along failure links where a concept ends.
+  *
+  * All overlapping matches are reported in a single left-to-right pass, in O(k + m) time
+  * for k input words and m matches, whatever the dictionary.
+  * Matches are ordered by last word, then from the longest to the shortest.
+  *
+  * Adding a concept invalidates the automaton, which is compiled again by freeze() or by the next extraction.
+  * Concurrent extractions are safe as long as no concept is added meanwhile.
+  */
+  class AhoCorasickConceptExtractor {
+
+  public:
+
+    using ConceptId = Concept::ConceptId;
+    using Match     = Concept::Match;
+
+    /// Vocabulary words are numbered in insertion order
+    using WordId = uint32_t;
+
+    /**
+    * Default constructor: no concepts
+    */
+    AhoCorasickConceptExtractor() : _built(false) {
+      _trieOutputs.push_back(NO_CONCEPT);
+    }
+
+    /**
+    * Construct concepts from list of null-terminated strings
+    */
+    AhoCorasickConceptExtractor(std::initializer_list<const char*> conceptList) : _built(false) {
+      _trieOutputs.push_back(NO_CONCEPT);
+      for (auto& concept : conceptList) addConcept(concept);
+    }
+
+    /**
+    * Construct concepts from a concept list file, with one concept per line
+    */
+    AhoCorasickConceptExtractor(const char* conceptFilePath) : _built(false) {
+      _trieOutputs.push_back(NO_CONCEPT);
+
+      std::ifstream conceptFile(conceptFilePath);
+
+      // Lines of any length, with LF or CRLF line breaks
+      for (std::string concept; std::getline(conceptFile, concept); ) {
+        if (!concept.empty() && concept[concept.size() - 1] == '\r') concept.resize(concept.size() - 1);
+        addConcept(concept.c_str());
+      }
+    }
+
+    /**
+    * Insert a concept in the trie
+    */
+    void addConcept(const char* concept) {
+      Vector<char> key(concept, strlen(concept));
+      ConceptExtractor::lowerCase(key);
+
+      Words keyWords(key, false);
+      if (keyWords.length() == 0) return;
+
+      _built.store(false, std::memory_order_relaxed);
+
+      uint32_t state = ROOT;
+      for (size_t i = 0; i < keyWords.length(); ++i) {
+        uint64_t transition = (static_cast<uint64_t>(state) << 32) | intern(keyWords.word(i));
+
+        auto entry = _transitions.find(transition);
+        if (entry != _transitions.end()) {
+          state = entry->second;
+          continue;
+        }
+
+        uint32_t child = static_cast<uint32_t>(_trieOutputs.size());
+        _transitions[transition] = child;
+
+        _trieOutputs.push_back(NO_CONCEPT);
+
+        state = child;
+      }
+
+      // A concept added again in another case keeps its ID
+      if (_trieOutputs[state] != NO_CONCEPT) {
+        _surfaces[_trieOutputs[state]] = concept;
+        return;
+      }
+
+      _trieOutputs[state] = static_cast<ConceptId>(_surfaces.size());
+
+      _surfaces.push_back(concept);
+
+      _wordCounts.push_back(static_cast<uint32_t>(keyWords.length()));
+    }
+
+    /**
+    * Compile the automaton, if concepts were added since the last compilation
+    * @return true
+    */
+    bool freeze() {
+      build();
+      return true;
+    }
+
+    /**
+    * @return true if the automaton is compiled
+    */
+    bool frozen() const {
+      return _built.load(std::memory_order_acquire);
+    }
+
+    /**
+    * @return the number of concepts
+    */
+    size_t conceptCount() const {
+      return _surfaces.size();
+    }
+
+    /**
+    * @return the number of distinct dictionary words
+    */
+    size_t vocabularySize() const {
+      return _vocabulary.size();
+    }
+
+    /**
+    * @return the number of double-array cells, states and free cells alike
+    */
+    size_t cellCount() const {
+      build();
+      return _cells.size();
+    }
+
+    /**
+    * @param id a concept ID, lower than conceptCount()
+    * @return the concept in its original case
+    */
+    View<char> concept(ConceptId id) const {
+      return View<char>(_surfaces[id].c_str(), _surfaces[id].length());
+    }
+
+    /**
+    * Extract concepts from an input text
+    * @param input The input text
+    * @return a vector of concepts, ordered by last word then from the longest
+    */
+    template <size_t N>
+    Vector<String<> > get(const String<N>& input) const {
+      Vector<char, N> lcInput(input);
+
+      Vector<uint32_t> boundaries;
+      Normalizer::normalize(lcInput, nullptr, &boundaries);
+
+      Words words(lcInput, boundaries);
+
+      Vector<String<> > result;
+      extract(words, [this, &result](size_t, size_t, ConceptId id) { result.push_back(concept(id)); });
+
+      return result;
+    }
+
+    /**
+    * Find the concepts of an input text with their positions
+    * @param input The input text
+    * @return the matches, ordered by last word then from the longest
+    */
+    template <size_t N>
+    Vector<Match> matches(const String<N>& input) const {
+      Vector<Match> result;
+      forEachMatch(input, [&result](const Match& match) { result.push_back(match); });
+
+      return result;
+    }
+
+    /**
+    * Visit the concepts of an input text with their positions.
+    * Matches are not stored, and concepts are not copied.
+    * @param input The input text
+    * @param visit a function taking a constant Match reference, ordered by last word then from the longest
+    */
+    template <size_t N, typename Visitor>
+    void forEachMatch(const String<N>& input, Visitor visit) const {
+      Vector<char, N> lcInput(input);
+
+      // positions[i] is the input offset of the i-th normalized character
+      Vector<uint32_t> positions, boundaries;
+      Normalizer::normalize(lcInput, &positions, &boundaries);
+
+      Words words(lcInput, boundaries);
+
+      extract(words, [&](size_t first, size_t wordCount, ConceptId id) {
+        size_t last = first + wordCount - 1;
+
+        Match match;
+        match.begin     = positions[words.offset(first)];
+        match.end       = positions[words.offset(last) + words.wordLength(last) - 1] + 1;
+        match.wordIndex = static_cast<uint32_t>(first);
+        match.conceptId = id;
+
+        visit(static_cast<const Match&>(match));
+      });
+    }
+
+  private:
+
+    static const uint32_t ROOT = 0;
+
+    /// Check of the cells that are not states
+    static const uint32_t FREE = UINT32_MAX;
+
+    /// Check of the root, which has no parent
+    static const uint32_t NO_PARENT = UINT32_MAX - 1;
+
+    /// End of output links
+    static const uint32_t NO_STATE = UINT32_MAX;
+
+    /**
+    * Double-array cell
+    */
+    struct Cell {
+      uint32_t  base;       ///< Children are at base + word ID
+      uint32_t  check;      ///< The parent state, NO_PARENT or FREE
+      uint32_t  fail;       ///< The state of the longest proper suffix in the trie
+      ConceptId output;     ///< The concept ending at the state, or NO_CONCEPT
+      uint32_t  outputLink; ///< The nearest state along failure links with an output, or NO_STATE
+    };
+
+    /**
+    * Hash of trie transitions, packed as (state << 32) | word ID
+    */
+    struct TransitionHash {
+      size_t operator()(uint64_t transition) const {
+        return static_cast<size_t>(mixBits(transition));
+      }
+    };
+
+    /**
+    * Run the automaton over the input words
+    * @param words the normalized input words
+    * @param visit a function taking the first word index, the word count and the ID of every concept
+    */
+    template <typename Visitor>
+    void extract(const Words& words, Visitor visit) const {
+      build();
+
+      uint32_t state = ROOT;
+      size_t last = 0;
+
+      for (; last < words.length(); ++last) {
+        auto entry = _vocabulary.find(words.word(last));
+
+        // No concept spans a word missing from the vocabulary
+        if (entry == _vocabulary.end()) {
+          state = ROOT;
+          continue;
+        }
+
+        state = next(state, entry->second);
+
+        uint32_t output = (_cells[state].output != NO_CONCEPT ? state : _cells[state].outputLink);
+        for (; output != NO_STATE; output = _cells[output].outputLink) {
+          ConceptId id = _cells[output].output;
+          size_t wordCount = _wordCounts[id];
+          visit(last + 1 - wordCount, wordCount, id);
+        }
+      }
+    }
+
+    /**
+    * Follow failure links until a transition on the word exists
+    * @return the next state
+    */
+    uint32_t next(uint32_t state, WordId word) const {
+      for (;;) {
+        size_t child = static_cast<size_t>(_cells[state].base) + word;
+        if (child < _cells.size() && _cells[child].check == state) return static_cast<uint32_t>(child);
+
+        if (state == ROOT) return ROOT;
+        state = _cells[state].fail;
+      }
+    }
+
+    /**
+    * Compile the trie to the double array, unless it is up to date.
+    * Concurrent callers wait for a single compilation.
+    */
+    void build() const {
+      if (_built.load(std::memory_order_acquire)) return;
+
+      std::lock_guard<std::mutex> lock(_buildMutex);
+      if (_built.load(std::memory_order_relaxed)) return;
+
+      size_t stateCount = _trieOutputs.size();
+
+      // Children of every trie state, sorted by word ID: (word ID, child state) from childOffsets[s]
+      Vector<size_t> childOffsets;
+      childOffsets.resize(stateCount + 1);
+      for (auto& offset : childOffsets) offset = 0;
+
+      _transitions.forEach([&childOffsets](const std::pair<uint64_t, uint32_t>& transition) {
+        ++childOffsets[static_cast<size_t>(transition.first >> 32) + 1];
+      });
+      for (size_t s = 0; s < stateCount; ++s) childOffsets[s + 1] += childOffsets[s];
+
+      Vector<std::pair<WordId, uint32_t> > children;
+      children.resize(_transitions.size());
+
+      Vector<size_t> filled;
+      filled.resize(stateCount);
+      for (size_t s = 0; s < stateCount; ++s) filled[s] = childOffsets[s];
+
+      _transitions.forEach([&](const std::pair<uint64_t, uint32_t>& transition) {
+        size_t parent = static_cast<size_t>(transition.first >> 32);
+        children[filled[parent]++] = std::make_pair(static_cast<WordId>(transition.first), transition.second);
+      });
+
+      for (size_t s = 0; s < stateCount; ++s) {
+        std::sort(children.data() + childOffsets[s], children.data() + childOffsets[s + 1]);
+      }
+
+      // Place the states breadth first. cellOf[s] is the cell of trie state s
+      Vector<uint32_t> order;
+      order.reserve(stateCount);
+      order.push_back(static_cast<uint32_t>(ROOT));
+
+      Vector<uint32_t> cellOf;
+      cellOf.resize(stateCount);
+      cellOf[ROOT] = ROOT;
+
+      _cells.resize(0);
+      grow(stateCount + _vocabulary.size() + 1);
+      _cells[ROOT].check = NO_PARENT;
+
+      size_t firstFree = 1;
+      for (size_t i = 0; i < order.size(); ++i) {
+        uint32_t parent = order[i];
+        const std::pair<WordId, uint32_t>* first = children.data() + childOffsets[parent];
+        size_t count = childOffsets[parent + 1] - childOffsets[parent];
+
+        if (count == 0) continue;
+
+        size_t base = findBase(first, count, firstFree);
+        grow(base + first[count - 1].first + 1);
+
+        _cells[cellOf[parent]].base = static_cast<uint32_t>(base);
+        for (size_t c = 0; c < count; ++c) {
+          size_t cell = base + first[c].first;
+          _cells[cell].check = cellOf[parent];
+          cellOf[first[c].second] = static_cast<uint32_t>(cell);
+          order.push_back(first[c].second);
+        }
+      }
+
+      // Failure and output links, breadth first so that shallower states are linked first
+      for (size_t i = 0; i < order.size(); ++i) {
+        uint32_t state = order[i];
+        Cell& cell = _cells[cellOf[state]];
+        cell.output = _trieOutputs[state];
+
+        if (state == ROOT) {
+          cell.fail = ROOT;
+          cell.outputLink = NO_STATE;
+          continue;
+        }
+
+        uint32_t parentCell = cell.check;
+        WordId word = static_cast<WordId>(cellOf[state] - _cells[parentCell].base);
+
+        cell.fail = (parentCell == ROOT ? ROOT : next(_cells[parentCell].fail, word));
+
+        const Cell& fail = _cells[cell.fail];
+        cell.outputLink = (fail.output != NO_CONCEPT ? cell.fail : fail.outputLink);
+      }
+
+      _built.store(true, std::memory_order_release);
+    }
+
+    /**
+    * Find a base where all the children cells are free
+    * @param children the children, sorted by word ID
+    * @param count the children count
+    * @param[in,out] firstFree the first free cell
+    * @return the base
+    */
+    size_t findBase(const std::pair<WordId, uint32_t>* children, size_t count, size_t& firstFree) const {
+      while (firstFree < _cells.size() && _cells[firstFree].check != FREE) ++firstFree;
+
+      // The first child takes the first free cell, unless its word ID is larger
+      size_t base = (firstFree > children[0].first ? firstFree - children[0].first : 0);
+
+      for (;; ++base) {
+        bool fits = true;
+        for (size_t c = 0; c < count && fits; ++c) {
+          size_t cell = base + children[c].first;
+          fits = (cell >= _cells.size() || _cells[cell].check == FREE);
+        }
+
+        if (fits) return base;
+      }
+    }
+
+    /**
+    * Extend the double array with free cells
+    */
+    void grow(size_t cellCount) const {
+      size_t size = _cells.size();
+      if (cellCount <= size) return;
+
+      _cells.resize(cellCount);
+
+      for (size_t i = size; i < cellCount; ++i) {
+        _cells[i].base = 0;
+        _cells[i].check = FREE;
+        _cells[i].fail = ROOT;
+        _cells[i].output = NO_CONCEPT;
+        _cells[i].outputLink = NO_STATE;
+      }
+    }
+
+    /**
+    * @return the ID of a dictionary word, numbering it if new
+    */
+    WordId intern(const View<char>& word) {
+      auto entry = _vocabulary.find(word);
+      if (entry != _vocabulary.end()) return entry->second;
+
+      WordId id = static_cast<WordId>(_vocabulary.size());
+      _vocabulary[Vector<char>(word.data(), word.size())] = id;
+
+      return id;
+    }
+
+    /// Dictionary words to word IDs
+    FlatHashTable<Vector<char>, WordId> _vocabulary;
+
+    /// Trie transitions, from (state << 32) | word ID to the child state
+    FlatHashTable<uint64_t, uint32_t, DEFAULT_SMALL_FLAT_HASHTABLE_SLOT_COUNT, TransitionHash> _transitions;
+
+    /// The concept ending at every trie state, or NO_CONCEPT
+    Vector<ConceptId> _trieOutputs;
+
+    /// Concepts in their original case, by concept ID
+    Vector<String<> > _surfaces;
+
+    /// Concept word counts, by concept ID
+    Vector<uint32_t> _wordCounts;
+
+    /// The compiled automaton
+    mutable Vector<Cell>      _cells;
+    mutable std::atomic<bool> _built;
+    mutable std::mutex        _buildMutex;
+  };
+
+} //end namespace Concept
+
+#endif
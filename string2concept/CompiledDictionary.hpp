@@ -0,0 +1,510 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_COMPILED_DICTIONARY_HPP
+#define CONCEPT_COMPILED_DICTIONARY_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "core/Bits.hpp"
+#include "core/MappedFile.hpp"
+#include "core/String.hpp"
+#include "core/Vector.hpp"
+#include "core/View.hpp"
+#include "ConceptEntry.hpp"
+
+namespace Concept {
+
+  /**
+  * Read-only concept dictionary, compiled to a binary file then served from a memory mapping.
+  * Opening a compiled file only validates its header: nothing is parsed, hashed or allocated,
+  * and pages are loaded on demand by the first lookups.
+  *
+  * The file holds, in native byte order:
+  * -# a header with the format version, the byte order and the hash of a probe key,
+  *   so that files built on another platform or with another hash function are rejected
+  * -# an open-addressing table of 32-byte slots, a power of two in count, filled at most by half.
+  *   Each slot holds the full key hash, the offset and length of the key, the concept ID
+  *   and the 64-bit mask of its word counts. Lookups probe linearly and compare the stored hash before the key.
+  * -# the concept table: the offset and length of the surface form of every concept ID
+  * -# the pool of key and surface form characters
+  *
+  * @tparam HashType the Hash function of the keys. It must accept character views.
+  */
+  template <typename HashType>
+  class CompiledDictionary {
+
+    struct Slot;
+
+  public:
+
+    static const uint32_t VERSION = 3;
+
+    /// Entries are served as views into the mapping: key, then concept ID and word counts
+    using Entry = std::pair<View<char>, ConceptEntry>;
+
+    /**
+    * Dictionary iterator, a proxy of the slot it points to
+    */
+    class const_iterator {
+
+    public:
+
+      const_iterator() : _slot(nullptr) {}
+
+      const_iterator(const CompiledDictionary& dictionary, const Slot* slot) : _slot(slot) {
+        if (_slot) _entry = dictionary.entry(*_slot);
+      }
+
+      const Entry& operator*() const {
+        return _entry;
+      }
+
+      const Entry* operator->() const {
+        return &_entry;
+      }
+
+      bool operator==(const const_iterator& other) const {
+        return _slot == other._slot;
+      }
+
+      bool operator!=(const const_iterator& other) const {
+        return _slot != other._slot;
+      }
+
+    private:
+      const Slot* _slot;
+      Entry       _entry;
+    };
+
+    /**
+    * Default constructor: no file mapped
+    */
+    CompiledDictionary() : _header(nullptr), _slots(nullptr) {}
+
+    /**
+    * Map a compiled dictionary, unmapping the previous one
+    * @param path the file path
+    * @return true if the file is a valid compiled dictionary for this platform and this hash function
+    */
+    bool open(const char* path) {
+      close();
+
+      if (!_file.open(path)) return false;
+
+      if (!valid()) {
+        _file.close();
+        return false;
+      }
+
+      _header = reinterpret_cast<const Header*>(_file.data());
+      _slots  = reinterpret_cast<const Slot*>(_file.data() + sizeof(Header));
+
+      return true;
+    }
+
+    /**
+    * Unmap the dictionary
+    */
+    void close() {
+      _file.close();
+      _header = nullptr;
+      _slots  = nullptr;
+    }
+
+    /**
+    * @return true if a dictionary is mapped
+    */
+    bool isOpen() const {
+      return _header != nullptr;
+    }
+
+    /**
+    * @return the number of entries
+    */
+    size_t size() const {
+      return _header ? static_cast<size_t>(_header->entryCount) : 0;
+    }
+
+    /**
+    * @return the number of concepts
+    */
+    size_t conceptCount() const {
+      return _header ? static_cast<size_t>(_header->conceptCount) : 0;
+    }
+
+    /**
+    * @param id a concept ID, lower than conceptCount()
+    * @return the surface form of the concept
+    */
+    View<char> concept(size_t id) const {
+      const ConceptSlot& slot = reinterpret_cast<const ConceptSlot*>(_file.data() + _header->conceptsOffset)[id];
+      return characters(slot.offset, slot.length);
+    }
+
+    /**
+    * @return the largest concept word count
+    */
+    size_t maxWordCount() const {
+      return _header ? static_cast<size_t>(_header->maxWordCount) : 0;
+    }
+
+    /**
+    * Find an entry
+    * @param key the key
+    * @return an iterator to the entry or end()
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key) const {
+      return find(key, HashType()(key));
+    }
+
+    /**
+    * Find an entry whose key hash was already computed
+    * @param key the key
+    * @param hash the key hash
+    * @return an iterator to the entry or end()
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key, size_t hash) const {
+      if (!_header) return end();
+
+      size_t mask = static_cast<size_t>(_header->slotCount) - 1;
+      for (size_t i = static_cast<size_t>(mixBits(hash)) & mask; ; i = (i + 1) & mask) {
+        const Slot& slot = _slots[i];
+
+        // Empty slot, the key is missing
+        if (slot.wordCounts == 0) return end();
+
+        if (slot.hash == static_cast<uint64_t>(hash) && key == characters(slot.keyOffset, slot.keyLength)) {
+          return const_iterator(*this, &slot);
+        }
+      }
+    }
+
+    /**
+    * @return the end iterator
+    */
+    const_iterator end() const {
+      return const_iterator();
+    }
+
+    /**
+    * Visit every entry
+    * @param visit a function taking a constant entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+      if (!_header) return;
+
+      for (size_t i = 0; i < _header->slotCount; ++i) {
+        if (_slots[i].wordCounts != 0) visit(static_cast<const Entry&>(entry(_slots[i])));
+      }
+    }
+
+    /**
+    * Compile a concept dictionary to a file
+    * @param table any Hash table of pairs (key, ConceptEntry) with a constant forEach
+    * @param conceptCount the number of concept IDs
+    * @param concept a function returning the surface form of a concept ID, as a View, a Vector or a String
+    * @param path the output file path
+    * @return true if the file was written
+    */
+    template <typename Table, typename Concepts>
+    static bool compile(const Table& table, size_t conceptCount, Concepts concept, const char* path) {
+
+      // Size the sections first
+      Measure measure;
+      table.forEach(std::ref(measure));
+
+      for (size_t id = 0; id < conceptCount; ++id) measure.characterCount += chars(concept(id)).size();
+
+      if (measure.characterCount > std::numeric_limits<uint32_t>::max() ||
+          conceptCount > std::numeric_limits<uint32_t>::max()) return false;
+
+      // Keep the table at most half full, so that linear probes stay short
+      size_t slotCount = MIN_SLOT_COUNT;
+      while (slotCount < 2 * measure.entryCount) slotCount <<= 1;
+
+      Layout layout;
+      layout.slots.resize(slotCount);
+      memset(layout.slots.data(), 0, slotCount * sizeof(Slot));
+      layout.characters.reserve(measure.characterCount);
+
+      table.forEach(Place(layout));
+
+      Vector<ConceptSlot> concepts;
+      concepts.resize(conceptCount);
+      for (size_t id = 0; id < conceptCount; ++id) {
+        layout.append(chars(concept(id)), concepts[id].offset, concepts[id].length);
+      }
+
+      Header header;
+      memset(&header, 0, sizeof(header));
+      memcpy(header.magic, MAGIC, sizeof(header.magic));
+      header.version       = VERSION;
+      header.byteOrder     = BYTE_ORDER_MARK;
+      header.hashCheck     = probeHash();
+      header.entryCount    = measure.entryCount;
+      header.slotCount     = slotCount;
+      header.maxWordCount   = measure.maxWordCount;
+      header.conceptCount   = conceptCount;
+      header.conceptsOffset = sizeof(Header) + slotCount * sizeof(Slot);
+      header.stringsOffset  = header.conceptsOffset + conceptCount * sizeof(ConceptSlot);
+      header.fileSize       = header.stringsOffset + layout.characters.size();
+
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+      file.write(reinterpret_cast<const char*>(layout.slots.data()), slotCount * sizeof(Slot));
+      file.write(reinterpret_cast<const char*>(concepts.data()), conceptCount * sizeof(ConceptSlot));
+      file.write(layout.characters.data(), layout.characters.size());
+
+      return static_cast<bool>(file);
+    }
+
+    /**
+    * @param path a file path
+    * @return true if the file starts like a compiled dictionary
+    */
+    static bool isCompiled(const char* path) {
+      std::ifstream file(path, std::ios::binary);
+      char magic[sizeof(MAGIC)];
+
+      return file.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(magic)) == 0;
+    }
+
+  private:
+
+    static const size_t   MIN_SLOT_COUNT  = 16;
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+    static constexpr char MAGIC[8] = {'S', '2', 'C', 'D', 'I', 'C', 'T', 0};
+
+    struct Header {
+      char     magic[8];
+      uint32_t version;
+      uint32_t byteOrder;
+      uint64_t hashCheck;
+      uint64_t entryCount;
+      uint64_t slotCount;
+      uint64_t maxWordCount;
+      uint64_t conceptCount;
+      uint64_t conceptsOffset;
+      uint64_t stringsOffset;
+      uint64_t fileSize;
+    };
+
+    struct Slot {
+      uint64_t hash;
+      uint32_t keyOffset;
+      uint32_t keyLength;
+      uint32_t conceptId;
+      uint32_t reserved;
+      uint64_t wordCounts;
+    };
+
+    struct ConceptSlot {
+      uint32_t offset;
+      uint32_t length;
+    };
+
+    /**
+    * The sections of a dictionary being compiled
+    */
+    struct Layout {
+      /**
+      * Append characters to the pool
+      * @param text the characters
+      * @param[out] offset their offset in the pool
+      * @param[out] length their length
+      */
+      void append(const View<char>& text, uint32_t& offset, uint32_t& length) {
+        offset = static_cast<uint32_t>(characters.size());
+        length = static_cast<uint32_t>(text.size());
+
+        characters.resize(offset + text.size());
+        if (text.size() > 0) memcpy(characters.data() + offset, text.data(), text.size());
+      }
+
+      Vector<Slot>     slots;
+      Vector<char>     characters;
+    };
+
+    /**
+    * Sizing visitor of a compilation
+    */
+    struct Measure {
+      Measure() : entryCount(0), characterCount(0), maxWordCount(0) {}
+
+      template <typename SourceEntry>
+      void operator()(const SourceEntry& entry) {
+        ++entryCount;
+        characterCount += chars(entry.first).size();
+
+        size_t wordCount = entry.second.maxWordCount();
+        if (wordCount > maxWordCount) maxWordCount = wordCount;
+      }
+
+      size_t entryCount;
+      size_t characterCount;
+      size_t maxWordCount;
+    };
+
+    /**
+    * Placement visitor of a compilation
+    */
+    struct Place {
+      explicit Place(Layout& layout) : layout(layout) {}
+
+      template <typename SourceEntry>
+      void operator()(const SourceEntry& entry) {
+        View<char> key = chars(entry.first);
+        size_t hash = HashType()(key);
+
+        size_t mask = layout.slots.size() - 1;
+        size_t i = static_cast<size_t>(mixBits(hash)) & mask;
+        while (layout.slots[i].wordCounts != 0) i = (i + 1) & mask;
+
+        Slot& slot = layout.slots[i];
+        slot.hash = hash;
+        slot.conceptId = entry.second.conceptId;
+        slot.wordCounts = entry.second.wordCounts;
+        layout.append(key, slot.keyOffset, slot.keyLength);
+      }
+
+      Layout& layout;
+    };
+
+    /**
+    * Character views of the source entry members
+    */
+    template <size_t N>
+    static View<char> chars(const Vector<char, N>& text) {
+      return View<char>(text.data(), text.size());
+    }
+
+    template <size_t N>
+    static View<char> chars(const String<N>& text) {
+      return View<char>(text.c_str(), text.length());
+    }
+
+    static View<char> chars(const View<char>& text) {
+      return text;
+    }
+
+    /**
+    * @return the hash of a fixed key, to detect files compiled with another hash function
+    */
+    static uint64_t probeHash() {
+      static const char probe[] = "string2concept dictionary";
+      return HashType()(View<char>(probe, sizeof(probe) - 1));
+    }
+
+    /**
+    * @return true if the mapped file is a compiled dictionary readable here
+    */
+    bool valid() const {
+      if (_file.size() < sizeof(Header)) return false;
+
+      const Header& header = *reinterpret_cast<const Header*>(_file.data());
+
+      if (memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0 ||
+          header.version != VERSION ||
+          header.byteOrder != BYTE_ORDER_MARK ||
+          header.hashCheck != probeHash() ||
+          header.fileSize != _file.size()) return false;
+
+      // Power of two slot count, at most half full so that lookups meet an empty slot
+      if (header.slotCount < MIN_SLOT_COUNT || (header.slotCount & (header.slotCount - 1)) != 0) return false;
+      if (header.entryCount > header.slotCount / 2) return false;
+
+      // Sections in order within the file, bounded before computing their offsets
+      if (header.slotCount > (header.fileSize - sizeof(Header)) / sizeof(Slot)) return false;
+      if (header.conceptsOffset != sizeof(Header) + header.slotCount * sizeof(Slot)) return false;
+
+      if (header.conceptCount > (header.fileSize - header.conceptsOffset) / sizeof(ConceptSlot)) return false;
+      if (header.stringsOffset != header.conceptsOffset + header.conceptCount * sizeof(ConceptSlot)) return false;
+
+      // Every key and surface form within the string pool, every concept ID within the concept table
+      uint64_t stringsSize = header.fileSize - header.stringsOffset;
+      const Slot* slots = reinterpret_cast<const Slot*>(_file.data() + sizeof(Header));
+      uint64_t entryCount = 0;
+
+      for (uint64_t i = 0; i < header.slotCount; ++i) {
+        const Slot& slot = slots[i];
+        if (slot.wordCounts == 0) continue;
+
+        ++entryCount;
+        if (uint64_t(slot.keyOffset) + slot.keyLength > stringsSize) return false;
+        if ((slot.wordCounts & 1) != 0 && slot.conceptId >= header.conceptCount) return false;
+      }
+
+      const ConceptSlot* concepts = reinterpret_cast<const ConceptSlot*>(_file.data() + header.conceptsOffset);
+      for (uint64_t id = 0; id < header.conceptCount; ++id) {
+        if (uint64_t(concepts[id].offset) + concepts[id].length > stringsSize) return false;
+      }
+
+      return entryCount == header.entryCount;
+    }
+
+    /**
+    * @return a view of the string pool
+    */
+    View<char> characters(uint32_t offset, uint32_t length) const {
+      return View<char>(_file.data() + _header->stringsOffset + offset, length);
+    }
+
+    /**
+    * @return the entry proxy of a slot
+    */
+    Entry entry(const Slot& slot) const {
+      ConceptEntry value;
+      value.conceptId  = slot.conceptId;
+      value.wordCounts = slot.wordCounts;
+
+      return Entry(characters(slot.keyOffset, slot.keyLength), value);
+    }
+
+    MappedFile    _file;
+    const Header* _header;
+    const Slot*   _slots;
+  };
+
+  template <typename HashType>
+  constexpr char CompiledDictionary<HashType>::MAGIC[8];
+
+} // end namespace Concept
+
+#endif
@@ -0,0 +1,84 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_CONCEPTENTRY_HPP
+#define CONCEPT_CONCEPTENTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/Bits.hpp"
+#include "Match.hpp"
+
+namespace Concept {
+
+  /**
+  * Dictionary value of a key, 16 bytes: the concept whose key it is, if any,
+  * and the set of word counts of the concepts starting with the key, as a bitmask.
+  * Surface forms are kept apart, by concept ID, since they are only read on a match.
+  */
+  struct ConceptEntry {
+
+    /// Word counts are bits of a 64-bit mask
+    static const size_t MAX_WORD_COUNT = 64;
+
+    ConceptId conceptId;  ///< The concept of the key, valid if the key is itself a concept
+    uint64_t  wordCounts; ///< Bit m - 1 is set if concepts of m words start with the key. Bit 0 if the key is a concept
+
+    ConceptEntry() : conceptId(NO_CONCEPT), wordCounts(0) {}
+
+    /**
+    * @return true if the key is itself a concept
+    */
+    bool isConcept() const {
+      return (wordCounts & 1) != 0;
+    }
+
+    /**
+    * Add a word count, between 1 and MAX_WORD_COUNT
+    */
+    void addWordCount(size_t wordCount) {
+      wordCounts |= uint64_t(1) << (wordCount - 1);
+    }
+
+    /**
+    * @return the largest word count, or 0
+    */
+    size_t maxWordCount() const {
+      size_t result = 0;
+      for (uint64_t counts = wordCounts; counts != 0; counts &= counts - 1) result = countTrailingZeros(counts) + 1;
+      return result;
+    }
+  };
+
+} // end namespace Concept
+
+#endif
@@ -32,13 +32,34 @@
 #ifndef CONCEPT_EXTRACTOR_HPP
 #define CONCEPT_EXTRACTOR_HPP
 
+#include <cerrno>
+#include <cstring>
 #include <initializer_list>
 #include <fstream>
+#include <istream>
 #include <utility>
 
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "CompiledDictionary.hpp"
+#include "ConceptEntry.hpp"
+#include "Match.hpp"
+#include "Normalizer.hpp"
+#include "TextPolicy.hpp"
+#include "UnicodeFolder.hpp"
+#include "core/Arena.hpp"
+#include "core/FlatHashTable.hpp"
 #include "core/HashTable.hpp"
+#include "core/MappedFile.hpp"
+#include "core/PerfectHashTable.hpp"
 #include "core/String.hpp"
+#include "core/ThreadPool.hpp"
 #include "core/Vector.hpp"
+#include "core/View.hpp"
 #include "Words.hpp"
 
 namespace Concept {
@@ -54,50 +75,114 @@ namespace Concept {
   * we store concepts in a Hash table keyed by lowercase words.
   * As core data structure, the Hash table is designed as follows :
   * -# the keys are lowercased concepts or the first word of concepts
-  * -# the values are pairs of the key in its original case , and a vector of concepts lengths (number of words)
+  * -# the values are ConceptEntry records of 16 bytes: the ID of the key concept, and a 64-bit mask of concepts lengths (number of words)
   *   - If that length is one, the item itself is a concept
   *   - If that length m is greater than 1, there exist concepts of size m in the hashtable.
   *     .
+  * Lengths are visited in increasing order by counting trailing zeros of the mask.
+  * Original case forms are kept apart, by concept ID, and only read on a match.
+  * Concepts have at most MAX_CONCEPT_WORD_COUNT words. Longer concepts are ignored.
   * Whenever we find an input word in the HashTable, we try to find the next m words.
   * Every match for the expected length is a Concept and must be returned.
-
+  * Concepts are numbered in insertion order. Their original case forms are stored once, by ID,
+  * so that matches are reported as IDs and positions rather than copies.
+  * Keys and original case forms are views into a character Arena owned by the extractor,
+  * so that loading costs no allocation per concept and destroying the dictionary frees a few blocks.
+  *
+  * Keys are hashed word by word with a rolling hash.
+  * Every input word is hashed once, then the hash of any run of m words is derived
+  * in constant time from prefix hashes, so that candidates are neither copied nor rehashed.
+  * Each input byte is thus hashed once whatever the concept lengths.
+  *
+  * The Hash table implementation is the Dictionary template parameter:
+  * HashTable, with chained buckets, or FlatHashTable, with open addressing.
+  * Separators, punctuation and case folding are defined by the Policy template parameter, a TextPolicy.
+  * Once all concepts are added, freeze() moves them to a minimal perfect Hash table.
+  * compile() writes them to a binary file that later constructions map instead of parsing.
+  *
+  * Extraction only reads the dictionary: get() may run concurrently on the same extractor,
+  * as long as no concept is added meanwhile. The batch get() spreads texts over a ThreadPool.
+  *
   * This algorithm's complexity in time is, on average, linear with
   * the number k of words in input + the average number l of words in the concepts
   * To that, we add a linear term for an initial segmentation of the text into words (zero-copy process)
   * i.e. O(k + l) + O(n).
   * Its theoretical worst-case is O(k*l) + O(n). That only occurs in the hypothetical case where all hashes collide.
-  * This implies a rather poor hash function.
+  * This implies a rather poor hash function, or keys crafted to collide:
+  * SeededConceptExtractor hashes words with SipHash-1-3 under a random key of the process
+  * for untrusted texts, and HashTable sorts any bucket that still grows long.
   *
   * We prefer this algorithm to the Aho-Corasick algorithm (AC). While AC achieves an interesting linear asymptotic worst-case time complexity O(n + m),
   * our algorithm might be faster because, as it jumps from word to word, it achieves less comparisions.
   * Indeed, Aho-Corasick's automata are character-oriented.
   */
-  class ConceptExtractor {
+  template <template <typename, typename, size_t, typename...> class Dictionary = HashTable,
+            typename Policy = DefaultTextPolicy,
+            typename WordImpl = WyHash>
+  class BasicConceptExtractor {
 
   public:
 
-    static const size_t MAX_CONCEPT_LENGTH = 1024;
+    /// Concept word counts are bits of a 64-bit mask
+    static const size_t MAX_CONCEPT_WORD_COUNT = ConceptEntry::MAX_WORD_COUNT;
+
+    /// Number of bytes read at once by stream()
+    static const size_t DEFAULT_STREAM_CHUNK_SIZE = 65536;
+
+    /// Number of bytes of a concept list prepared by one task of addConcepts()
+    static const size_t BULK_CHUNK_SIZE = 1 << 20;
+
+    /// The hash of concept keys, composable word by word. Words are hashed by WordImpl
+    using WordHash = RollingWordHash<WordImpl>;
+
+    using ConceptId = Concept::ConceptId;
+    using Match     = Concept::Match;
+
+    /// Words and normalization following the text policy
+    using Words      = BasicWords<Policy>;
+    using Normalizer = BasicNormalizer<Policy>;
+
+    /**
+    * Default constructor: no concepts
+    */
+    BasicConceptExtractor() : _frozen(false), _loaded(true), _maxKeyLength(0) {}
 
     /**
     * Construct concepts from list of null-terminated strings
     */
-    ConceptExtractor(std::initializer_list<const char*> conceptList) {
+    BasicConceptExtractor(std::initializer_list<const char*> conceptList) : _frozen(false), _loaded(true), _maxKeyLength(0) {
       for (auto& concept : conceptList) addConcept(concept);
     }
 
     /**
-    * Construct concepts from a file path
+    * Construct concepts from a file path, either a concept list with one concept per line
+    * or a dictionary written by compile(). The latter is mapped rather than read.
+    * A concept list is mapped too, then added by addConcepts() over one thread per hardware thread.
+    * loaded() tells whether the file could be read.
     */
-    ConceptExtractor(const char* conceptFilePath) {
-
-      std::ifstream conceptFile(conceptFilePath);
-      Vector<char> concept;
+    BasicConceptExtractor(const char* conceptFilePath) : _frozen(false), _maxKeyLength(0) {
 
-      concept.reserve(MAX_CONCEPT_LENGTH);
+      if (CompiledDictionary<KeyHash>::isCompiled(conceptFilePath)) {
+        _loaded = _compiledConcepts.open(conceptFilePath);
+        if (!_loaded) return;
 
-      while (conceptFile.getline(concept.data(), concept.capacity())) {
-        addConcept(concept.data());
+        updateBasePowers(_compiledConcepts.maxWordCount());
+        _compiledConcepts.forEach([this](const typename CompiledDictionary<KeyHash>::Entry& entry) {
+          if (entry.first.size() > _maxKeyLength) _maxKeyLength = entry.first.size();
+        });
+        return;
       }
+
+      ThreadPool pool;
+      _loaded = addConcepts(conceptFilePath, pool);
+    }
+
+    /**
+    * @return false if the concept file of the constructor could not be read: missing, corrupt,
+    * or a dictionary compiled for another platform or hash function. The dictionary is then empty
+    */
+    bool loaded() const {
+      return _loaded;
     }
 
     /**
@@ -107,83 +192,272 @@ namespace Concept {
 
       // Insert the concept to the hash table with
       // its lowercase version as key
-      Vector<char> key(concept, strlen(concept));
-      lowerCase(key);
-      _concepts[key].first = concept;
-      _concepts[key].second.insert(1, Vector<size_t>::Insertion::ORDERED |
-                                      Vector<size_t>::Insertion::UNIQUE);
+      Vector<char> keys;
+      Vector<char> buffer;
+      PreparedConcept prepared;
 
-      // Insert the number of words in the concept into 
-      // the Hashtable element keyed by the concept's first word
-      Words keyWords(key);
+      if (!prepare(View<char>(concept, strlen(concept)), buffer, keys, prepared)) return;
 
-      // *(keyWords.begin() is the first word
-      _concepts[*(keyWords.begin())].second.insert(keyWords.length(),
-                                                    Vector<size_t>::Insertion::ORDERED |
-                                                    Vector<size_t>::Insertion::UNIQUE);
+      // A frozen dictionary is read-only
+      thaw();
+
+      insert(prepared, keys.data());
+    }
+
+    /**
+    * Insert the concepts of a concept list, one per line of any length, in line order.
+    * Lines are lowercased, split and hashed in parallel, chunk by chunk,
+    * then the Hash table is sized once for all of them and filled by the caller.
+    * Concept IDs thus follow the lines, as if every line was added by addConcept().
+    * @param lines the concept list. Line breaks are \n or \r\n
+    * @param pool the threads preparing the chunks
+    */
+    void addConcepts(const View<char>& lines, ThreadPool& pool) {
+
+      // Chunks start at the first line starting past a multiple of BULK_CHUNK_SIZE
+      size_t chunkCount = (lines.size() + BULK_CHUNK_SIZE - 1) / BULK_CHUNK_SIZE;
+      Vector<PreparedChunk> chunks;
+      chunks.resize(chunkCount);
+
+      pool.run(chunkCount, [&lines, &chunks](size_t i) {
+        size_t begin = lineStart(lines, i * BULK_CHUNK_SIZE);
+        size_t end   = lineStart(lines, (i + 1) * BULK_CHUNK_SIZE);
+
+        prepare(View<char>(lines.data() + begin, end - begin), chunks[i]);
+      });
+
+      // Size the tables once, for every key and first word at worst
+      size_t conceptCount = 0;
+      size_t keyCount = 0;
+      for (auto& chunk : chunks) {
+        conceptCount += chunk.concepts.size();
+        keyCount += chunk.concepts.size() + chunk.multiWordCount;
+      }
+
+      if (conceptCount == 0) return;
+
+      thaw();
+      _concepts.reserve(_concepts.size() + keyCount);
+      _surfaces.reserve(_surfaces.size() + conceptCount);
+
+      for (auto& chunk : chunks) {
+        for (auto& prepared : chunk.concepts) insert(prepared, chunk.keys.data());
+      }
+    }
+
+    /**
+    * Insert the concepts of a concept list file, mapped rather than read
+    * @param conceptFilePath the concept list path, one concept per line
+    * @param pool the threads preparing the concepts
+    * @return false if the file could not be mapped
+    */
+    bool addConcepts(const char* conceptFilePath, ThreadPool& pool) {
+      MappedFile conceptFile(conceptFilePath);
+      if (!conceptFile.isOpen()) return false;
+
+      addConcepts(View<char>(conceptFile.data(), conceptFile.size()), pool);
+
+      return true;
+    }
+
+    /**
+    * Freeze the dictionary once all concepts are added.
+    * Entries move to a minimal perfect Hash table: every lookup costs one hash,
+    * one slot and one key comparison, and there is no load factor slack.
+    * Adding a concept afterwards thaws the dictionary back to the Hash table.
+    * @return true if frozen. Otherwise the keys could not be separated and the dictionary is unchanged
+    */
+    bool freeze() {
+      if (frozen()) return true;
+
+      if (!_frozenConcepts.build(_concepts)) return false;
+
+      _concepts.clear();
+      _frozen = true;
+
+      return true;
+    }
+
+    /**
+    * @return true if the dictionary is frozen or mapped from a compiled file
+    */
+    bool frozen() const {
+      return _frozen || _compiledConcepts.isOpen();
+    }
+
+    /**
+    * Write the dictionary to a binary file, which the file path constructor maps
+    * @param path the output file path
+    * @return true if written. Always false with a seeded word hash, whose key only lives in this process
+    */
+    bool compile(const char* path) const {
+      if (IsSeededHash<WordImpl>::value) return false;
+
+      auto surface = [this](size_t id) { return concept(static_cast<ConceptId>(id)); };
+
+      if (_compiledConcepts.isOpen()) {
+        return CompiledDictionary<KeyHash>::compile(_compiledConcepts, conceptCount(), surface, path);
+      }
+
+      if (_frozen) return CompiledDictionary<KeyHash>::compile(_frozenConcepts, conceptCount(), surface, path);
+
+      return CompiledDictionary<KeyHash>::compile(_concepts, conceptCount(), surface, path);
+    }
+
+    /**
+    * @return the number of concepts
+    */
+    size_t conceptCount() const {
+      return _compiledConcepts.isOpen() ? _compiledConcepts.conceptCount() : _surfaces.size();
+    }
+
+    /**
+    * @param id a concept ID, lower than conceptCount()
+    * @return the concept in its original case
+    */
+    View<char> concept(ConceptId id) const {
+      if (_compiledConcepts.isOpen()) return _compiledConcepts.concept(id);
+
+      return _surfaces[id];
     }
 
     /**
     * Extract concepts from an input text
     * @param input The input text
     * @return a vector of concepts
+    * @throw std::length_error if the input exceeds 4 GiB, the range of 32-bit word offsets. stream() has no limit
     */
     template <size_t N>
-    Vector<String<> > get(const String<N>& input) {
+    Vector<String<> > get(const String<N>& input) const {
       Vector<char, N> lcInput(input);
- 
-      normalize(lcInput);
 
-      Words words(lcInput, false);
+      Vector<uint32_t> boundaries;
+      Normalizer::normalize(lcInput, nullptr, &boundaries);
+
+      Words words(lcInput, boundaries, WordHasher());
 
       Vector<String<> > result;
-      for (auto itFirst = words.begin(); itFirst != words.end(); ++itFirst) {
+      extract(words, words.length(), [this, &result](size_t, size_t, ConceptId id) {
+        result.push_back(concept(id));
+      });
 
-        // Lock for the current word among concepts
-        auto entry = _concepts.find(*itFirst);
+      return result;
+    }
 
-        // Move to the next word if no concept starts with that word
-        if (entry == _concepts.end()) continue;
+    /**
+    * Find the concepts of an input text with their positions
+    * @param input The input text
+    * @return the matches, ordered by first word then by word count
+    * @throw std::length_error if the input exceeds 4 GiB, the range of Match offsets
+    */
+    template <size_t N>
+    Vector<Match> matches(const String<N>& input) const {
+      Vector<Match> result;
+      forEachMatch(input, [&result](const Match& match) { result.push_back(match); });
 
-        // A concept starting with that word was found
-        for (auto& wordCount: entry->second.second) {
+      return result;
+    }
 
-          // if starting from itFirst, this number of words cannot be found in the text, 
-          // exit this loop
-          if (itFirst + wordCount > words.end()) break;
+    /**
+    * Visit the concepts of an input text with their positions.
+    * Matches are not stored, and concepts are not copied.
+    * @param input The input text
+    * @param visit a function taking a constant Match reference, ordered by first word then by word count
+    * @throw std::length_error if the input exceeds 4 GiB, the range of Match offsets
+    */
+    template <size_t N, typename Visitor>
+    void forEachMatch(const String<N>& input, Visitor visit) const {
+      Vector<char, N> lcInput(input);
 
-          if (wordCount == 1) {
-            // The word itself is a concept
-            result.push_back(entry->second.first);
+      // positions[i] is the input offset of the i-th normalized character
+      Vector<uint32_t> positions, boundaries;
+      Normalizer::normalize(lcInput, &positions, &boundaries);
 
-          } else {
+      Words words(lcInput, boundaries, WordHasher());
 
-            // The entry is the first word of some concepts, the get next wordCount words
-            auto key = words.get(itFirst, wordCount);
+      extract(words, words.length(), [&](size_t first, size_t wordCount, ConceptId id) {
+        size_t last = first + wordCount - 1;
 
-            // Lookup that key
-            auto concept = _concepts.find(key);
-            if (concept == _concepts.end()) continue;
+        Match match;
+        match.begin     = positions[words.offset(first)];
+        match.end       = positions[words.offset(last) + words.wordLength(last) - 1] + 1;
+        match.wordIndex = static_cast<uint32_t>(first);
+        match.conceptId = id;
 
-            // Concept found at key, add to result
-            result.push_back(concept->second.first);
-          }
-        }
-      }
+        visit(static_cast<const Match&>(match));
+      });
+    }
 
-      return result;
+    /**
+    * Extract concepts from a stream, chunk by chunk.
+    * Each chunk is normalized and split into words. The last words, as many as the longest concept
+    * minus one, are carried over to the next chunk, so that concepts straddling chunks are found once.
+    * A word longer than the longest concept cannot be part of one: it is skipped up to the next separator,
+    * so that memory is bounded by the chunk size and the longest concepts, whatever the stream size.
+    * Words are split by the text policy, as by get(): line breaks and tabs only separate words
+    * under a policy counting them as separators, such as the one of ExtendedConceptExtractor.
+    * @param input The input stream
+    * @param visit a function taking the character view of every concept, called as soon as found
+    * @param chunkSize the number of bytes read at once
+    */
+    template <typename Visitor>
+    void stream(std::istream& input, Visitor visit, size_t chunkSize = DEFAULT_STREAM_CHUNK_SIZE) const {
+      streamChunks([&input](char* buffer, size_t size) -> size_t {
+        input.read(buffer, size);
+        return static_cast<size_t>(input.gcount());
+      }, visit, chunkSize);
+    }
+
+    /**
+    * Extract concepts from a file descriptor, chunk by chunk.
+    * @see stream(std::istream&, Visitor, size_t)
+    * @param fd The input file descriptor, read until its end or a read error
+    * @param visit a function taking the character view of every concept, called as soon as found
+    * @param chunkSize the number of bytes read at once
+    */
+    template <typename Visitor>
+    void stream(int fd, Visitor visit, size_t chunkSize = DEFAULT_STREAM_CHUNK_SIZE) const {
+      streamChunks([fd](char* buffer, size_t size) -> size_t {
+#if defined(_WIN32)
+        int count = _read(fd, buffer, static_cast<unsigned int>(size));
+#else
+        ssize_t count;
+        do {
+          count = ::read(fd, buffer, size);
+        } while (count < 0 && errno == EINTR);
+#endif
+        return count > 0 ? static_cast<size_t>(count) : 0;
+      }, visit, chunkSize);
+    }
+
+    /**
+    * Extract concepts from a batch of input texts, spread over the threads of a pool.
+    * The threads share the dictionary, which must not change during the call.
+    * @param inputs The input texts
+    * @param pool The threads
+    * @return the vectors of concepts of every input, in input order
+    */
+    template <size_t N>
+    Vector<Vector<String<> > > get(const View<String<N> >& inputs, ThreadPool& pool) const {
+      Vector<Vector<String<> > > results;
+      results.resize(inputs.size());
+
+      // Every task writes its own result
+      pool.run(inputs.size(), [&](size_t i) { results[i] = get(inputs[i]); });
+
+      return results;
     }
 
     /**
-    * Lowercase ASCII characters
+    * Fold characters as the text policy does, lowercasing ASCII letters by default, and write separators as spaces
     * @param[in,out] asciiText The text that will be subsequently modified.
     */
     template <size_t N>
     static void lowerCase(Vector<char, N>& asciiText) {
 
-      for (auto& c : asciiText) {
-        if (c >= 'A' && c <= 'Z') c += 'a'-'A';
-      }
+      if (Policy::unicodeFolding() != NO_UNICODE_FOLDING) UnicodeFolder::fold(asciiText, Policy::unicodeFolding());
+
+      for (auto& c : asciiText) c = Policy::isSeparator(c) ? ' ' : Policy::fold(c);
     }
 
     /**
@@ -193,47 +467,474 @@ namespace Concept {
     */
     template <size_t N>
     static void normalize(Vector<char, N>& text) {
+      Normalizer::normalize(text);
+    }
+
+    /**
+    * Normalize a text, tracking where characters move
+    * @param[in,out] text The text that will be subsequently modified.
+    * @param track a function taking the new offset then the former offset of every kept character
+    */
+    template <size_t N, typename Track>
+    static void normalize(Vector<char, N>& text, Track track) {
+      Vector<uint32_t> positions;
+      Normalizer::normalize(text, &positions);
+
+      for (size_t i = 0; i < positions.size(); ++i) track(i, positions[i]);
+    }
+
+    /**
+    * @return true if ch is a punctuation character
+    */
+    static bool isPunctuation(char ch) {
+      return Policy::isPunctuation(ch);
+    }
 
-      lowerCase(text);
-
-      size_t offset = 0;
-      for (auto it = text.begin(); it != text.end(); ++it) {
-
-        if (isPunctuation(*it) ||
-            (Words::isSeparator(*it) &&
-              (it == text.begin()        ||
-               (it + 1) == text.end()    ||
-                *(it + 1) == 0           ||
-                isPunctuation(*(it + 1)) ||
-                Words::isSeparator(*(it + 1))
-               )
-              )
-             ) {
-          ++offset;
+  private:
+
+    using Key     = View<char>;
+    using Value   = ConceptEntry;
+    using KeyHash = Hash<View<char>, WordHash>;
+
+    /**
+    * A concept lowercased, split and hashed, ready to insert
+    */
+    struct PreparedConcept {
+      size_t      keyHash;         ///< The hash of the key
+      size_t      firstWordHash;   ///< The hash of the first word of the key
+      const char* surface;         ///< The concept in its original case
+      uint32_t    surfaceLength;
+      uint32_t    keyOffset;       ///< The offset of the key in the key buffer
+      uint32_t    keyLength;
+      uint32_t    firstWordOffset; ///< The offset of the first word in the key
+      uint32_t    firstWordLength;
+      uint32_t    wordCount;
+    };
+
+    /**
+    * The concepts prepared from a chunk of a concept list, and their keys
+    */
+    struct PreparedChunk {
+      PreparedChunk() : multiWordCount(0) {}
+
+      Vector<PreparedConcept> concepts;
+      Vector<char>            keys;
+      size_t                  multiWordCount; ///< The number of concepts of several words
+    };
+
+    /**
+    * Lowercase, split and hash a concept, appending its key to a key buffer.
+    * It only reads the extractor policy, hence runs concurrently.
+    * @param concept the concept in its original case
+    * @param buffer a work buffer
+    * @param[in,out] keys the key buffer
+    * @param[out] prepared the prepared concept
+    * @return false if the concept has no word or more than MAX_CONCEPT_WORD_COUNT words
+    */
+    static bool prepare(const View<char>& concept, Vector<char>& buffer, Vector<char>& keys, PreparedConcept& prepared) {
+      buffer.resize(concept.size());
+      if (concept.size() > 0) memcpy(buffer.data(), concept.data(), concept.size());
+      lowerCase(buffer);
+
+      // Count the words, and locate the first one. Separators are spaces once lowercased
+      size_t wordCount = 0;
+      size_t firstWordOffset = 0;
+      size_t firstWordLength = 0;
+
+      for (size_t i = 0; i < buffer.size(); ) {
+        if (Words::isSeparator(buffer[i])) { ++i; continue; }
+
+        size_t wordStart = i;
+        while (i < buffer.size() && !Words::isSeparator(buffer[i])) ++i;
+
+        if (wordCount++ == 0) {
+          firstWordOffset = wordStart;
+          firstWordLength = i - wordStart;
+        }
+      }
+
+      if (wordCount == 0 || wordCount > MAX_CONCEPT_WORD_COUNT) return false;
+
+      prepared.surface         = concept.data();
+      prepared.surfaceLength   = static_cast<uint32_t>(concept.size());
+      prepared.keyOffset       = static_cast<uint32_t>(keys.size());
+      prepared.keyLength       = static_cast<uint32_t>(buffer.size());
+      prepared.firstWordOffset = static_cast<uint32_t>(firstWordOffset);
+      prepared.firstWordLength = static_cast<uint32_t>(firstWordLength);
+      prepared.wordCount       = static_cast<uint32_t>(wordCount);
+      prepared.keyHash         = KeyHash()(View<char>(buffer.data(), buffer.size()));
+      prepared.firstWordHash   = KeyHash()(View<char>(buffer.data() + firstWordOffset, firstWordLength));
+
+      keys += buffer;
+
+      return true;
+    }
+
+    /**
+    * Prepare every line of a chunk of a concept list
+    * @param lines the lines of the chunk
+    * @param[out] chunk the prepared concepts
+    */
+    static void prepare(const View<char>& lines, PreparedChunk& chunk) {
+      Vector<char> buffer;
+      chunk.keys.reserve(lines.size());
+
+      for (const char* line = lines.data(); line < lines.end(); ) {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', lines.end() - line));
+        if (lineEnd == nullptr) lineEnd = lines.end();
+
+        size_t length = lineEnd - line;
+        if (length > 0 && line[length - 1] == '\r') --length;
+
+        PreparedConcept prepared;
+        if (prepare(View<char>(line, length), buffer, chunk.keys, prepared)) {
+          chunk.concepts.push_back(prepared);
+          chunk.multiWordCount += (prepared.wordCount > 1);
+        }
+
+        line = lineEnd + 1;
+      }
+    }
+
+    /**
+    * @return the offset of the first line starting at or after an offset, or the size of the lines
+    */
+    static size_t lineStart(const View<char>& lines, size_t offset) {
+      if (offset == 0) return 0;
+      if (offset >= lines.size()) return lines.size();
+
+      const char* lineBreak = static_cast<const char*>(memchr(lines.data() + offset - 1, '\n', lines.size() - offset + 1));
+
+      return lineBreak ? lineBreak + 1 - lines.data() : lines.size();
+    }
+
+    /**
+    * Insert a prepared concept: its key, numbered unless already a concept in another case,
+    * and its word count under its first word.
+    * @param prepared the prepared concept
+    * @param keys the key buffer of the prepared concept
+    */
+    void insert(const PreparedConcept& prepared, const char* keys) {
+      const char* key = keys + prepared.keyOffset;
+
+      Value& value = findOrCreate(View<char>(key, prepared.keyLength), prepared.keyHash);
+      if (prepared.keyLength > _maxKeyLength) _maxKeyLength = prepared.keyLength;
+
+      View<char> surface = _characters.copy(View<char>(prepared.surface, prepared.surfaceLength));
+
+      if (!value.isConcept()) {
+        value.conceptId = static_cast<ConceptId>(_surfaces.size());
+
+        _surfaces.push_back(surface);
+      } else {
+        _surfaces[value.conceptId] = surface;
+      }
+
+      value.addWordCount(1);
+
+      // Insert the number of words in the concept into 
+      // the Hashtable element keyed by the concept's first word
+      findOrCreate(View<char>(key + prepared.firstWordOffset, prepared.firstWordLength),
+                   prepared.firstWordHash).addWordCount(prepared.wordCount);
+
+      updateBasePowers(prepared.wordCount);
+    }
+
+    /**
+    * Read a stream chunk by chunk, then extract concepts from the chunk and the words carried over
+    * @param read a function filling a buffer, returning the number of bytes read. Zero means the stream end
+    * @param visit a function taking the character view of every concept
+    * @param chunkSize the number of bytes read at once
+    */
+    template <typename Read, typename Visitor>
+    void streamChunks(Read read, Visitor visit, size_t chunkSize) const {
+      if (chunkSize == 0) chunkSize = DEFAULT_STREAM_CHUNK_SIZE;
+
+      // Words that may start a concept ending in the next chunk
+      size_t carriedWordCount = _basePowers.size() > 1 ? _basePowers.size() - 2 : 0;
+
+      // Carried words, then the unfinished last word, then the chunk
+      Vector<char> window;
+      window.reserve(chunkSize);
+
+      Vector<uint32_t> boundaries;
+
+      // true while skipping the rest of a word too long to be part of a concept
+      bool skipping = false;
+
+      for (bool end = false; !end; ) {
+
+        size_t carried = window.size();
+        window.resize(carried + chunkSize);
+
+        size_t count = read(window.data() + carried, chunkSize);
+        window.resize(carried + count);
+        end = (count == 0);
+
+        // Drop the rest of a skipped word, up to the next separator
+        if (skipping) {
+          size_t skipped = carried;
+          while (skipped < window.size() && !Words::isSeparator(window[skipped])) ++skipped;
+
+          skipping = (skipped == window.size());
+          memmove(window.data() + carried, window.data() + skipped, window.size() - skipped);
+          window.resize(window.size() - (skipped - carried));
+        }
+
+        // Hold back the last word until the next chunk tells whether it is complete
+        size_t cut = window.size();
+        if (!end) {
+          while (cut > 0 && !Words::isSeparator(window[cut - 1])) --cut;
+        }
+
+        // A long unfinished word is normalized ahead, since punctuation and folding may shorten it.
+        // Still too long, it cannot be part of a concept: it is skipped, and so are the concepts starting before it
+        bool tooLong = false;
+        if (!end && window.size() - cut > _maxKeyLength) {
+          tooLong = (shorten(window, cut) > _maxKeyLength);
+        }
+
+        // Normalize the complete words in place
+        Vector<char> text(window.data(), cut, false);
+        Normalizer::normalize(text, nullptr, &boundaries);
+
+        Words words(text, boundaries, WordHasher());
+
+        // Concepts may start at the last words only once the next chunk is read
+        size_t startCount = words.length();
+        if (!end && !tooLong) startCount = startCount > carriedWordCount ? startCount - carriedWordCount : 0;
+
+        extract(words, startCount, [this, &visit](size_t, size_t, ConceptId id) { visit(concept(id)); });
+
+        if (tooLong) {
+          window.resize(0);
+          skipping = true;
           continue;
-         }
+        }
 
+        // Carry over the unvisited words and a separator, then the unfinished word
+        size_t carriedSize = 0;
+        size_t unfinishedSize = window.size() - cut;
 
+        if (startCount < words.length()) {
+          size_t carriedStart = words.offset(startCount);
+          carriedSize = text.size() - carriedStart;
+          memmove(window.data(), window.data() + carriedStart, carriedSize);
 
-        *(it - offset) = *it;
+          if (carriedSize + 1 + unfinishedSize > window.size()) window.resize(carriedSize + 1 + unfinishedSize);
+          memmove(window.data() + carriedSize + 1, window.data() + cut, unfinishedSize);
+          window[carriedSize++] = ' ';
+        } else {
+          memmove(window.data(), window.data() + cut, unfinishedSize);
+        }
+
+        window.resize(carriedSize + unfinishedSize);
       }
+    }
+
+    /**
+    * Normalize the unfinished word ending a stream window, but a trailing lead byte
+    * that may start a UTF-8 character completed by the next chunk
+    * @param[in,out] window the stream window
+    * @param cut the offset of the unfinished word
+    * @return the normalized length of the word
+    */
+    static size_t shorten(Vector<char>& window, size_t cut) {
+      size_t tail = (static_cast<unsigned char>(*window.last()) & 0xC0) == 0xC0 ? 1 : 0;
+      char lead = *window.last();
+
+      Vector<char> word(window.data() + cut, window.size() - cut - tail, false);
+      Normalizer::normalize(word);
 
-      text.resize(text.size() - offset);
+      window.resize(cut + word.size() + tail);
+      if (tail) *window.last() = lead;
+
+      return word.size();
     }
 
     /**
-    * @return true if ch is a punctuation character
+    * Hash of the characters of a word, filling the hash column of Words
     */
-    static bool isPunctuation(char ch) {
-      static const Vector<char> punctuation = {',', ';', '.', '!', '?' };
-      return punctuation.contains(ch);
+    struct WordHasher {
+      size_t operator()(const char* word, size_t len) const {
+        return WordHash::word(word, len);
+      }
+    };
+
+    /**
+    * Chain the word hashes, then lookup the concepts in the current dictionary
+    * @param words the normalized input words, hashed by WordHasher
+    * @param startCount the number of first words where concepts may start. Next words may only end concepts
+    * @param visit a function taking the first word index, the word count and the ID of every concept
+    */
+    template <typename Visitor>
+    void extract(const Words& words, size_t startCount, Visitor visit) const {
+
+      // prefixHashes[i] is the hash of the i first words
+      Vector<size_t> prefixHashes;
+      prefixHashes.resize(words.length() + 1);
+      prefixHashes[0] = 0;
+
+      for (size_t i = 0; i < words.length(); ++i) {
+        prefixHashes[i + 1] = WordHash::combine(prefixHashes[i], words.hash(i));
+      }
+
+      if (_compiledConcepts.isOpen()) return extract(_compiledConcepts, words, prefixHashes, startCount, visit);
+      if (_frozen) return extract(_frozenConcepts, words, prefixHashes, startCount, visit);
+
+      extract(_concepts, words, prefixHashes, startCount, visit);
     }
 
-  private:
+    /**
+    * Lookup the concepts starting at every word
+    * @param concepts the Hash table of concepts
+    * @param words the normalized input words
+    * @param prefixHashes the rolling hashes of the words
+    * @param startCount the number of first words where concepts may start
+    * @param visit a function taking the first word index, the word count and the ID of every concept
+    */
+    template <typename Table, typename Visitor>
+    void extract(const Table& concepts, const Words& words, const Vector<size_t>& prefixHashes,
+                 size_t startCount, Visitor visit) const {
+
+      size_t wordTotal = words.length();
+
+      for (size_t first = 0; first < startCount; ++first) {
+
+        // Look up the current word by the hash computed when splitting the text
+        auto entry = concepts.find(words.word(first), words.hash(first));
+
+        // Move to the next word if no concept starts with that word
+        if (entry == concepts.end()) continue;
+
+        // A concept starting with that word was found: visit its word counts in increasing order
+        for (uint64_t wordCounts = entry->second.wordCounts; wordCounts != 0; wordCounts &= wordCounts - 1) {
+          size_t wordCount = countTrailingZeros(wordCounts) + 1;
+
+          // if starting from first, this number of words cannot be found in the text, 
+          // exit this loop
+          if (first + wordCount > wordTotal) break;
+
+          if (wordCount == 1) {
+            // The word itself is a concept
+            visit(first, 1, entry->second.conceptId);
+
+          } else {
+
+            // The word starts concepts of wordCount words: view those words in place, without copying them
+            auto key = words.view(first, wordCount);
+
+            // Look up that key by the hash of its words, derived from the prefix hashes in constant time
+            auto concept = concepts.find(key, WordHash::span(prefixHashes[first],
+                                                             prefixHashes[first + wordCount],
+                                                             _basePowers[wordCount]));
+            if (concept == concepts.end()) continue;
+
+            // Concept found at key, visit it
+            visit(first, wordCount, concept->second.conceptId);
+          }
+        }
+      }
+    }
+
+    /**
+    * Keep the powers of the rolling hash base up to the longest concept
+    * @param wordCount the concept word count
+    */
+    void updateBasePowers(size_t wordCount) {
+      if (_basePowers.size() == 0) _basePowers.push_back(1);
+      while (_basePowers.size() <= wordCount) {
+        _basePowers.push_back(*_basePowers.last() * WordHash::BASE);
+      }
+    }
+
+    /**
+    * Find or create the Hash table entry of a key, copying a new key to the arena
+    * @param key the lowercase key
+    * @param hash the hash of the key
+    * @return the entry value
+    */
+    Value& findOrCreate(const View<char>& key, size_t hash) {
+      auto entry = _concepts.find(key, hash);
+
+      // The table itself is not constant, only its lookup interface
+      if (entry != _concepts.end()) return const_cast<Value&>(entry->second);
+
+      return _concepts.insert(_characters.copy(key), hash);
+    }
+
+    /**
+    * Move the entries of a frozen or compiled dictionary back to the Hash table
+    */
+    void thaw() {
+      if (_compiledConcepts.isOpen()) {
+        // Copy the mapped keys and original case forms before unmapping them
+        _surfaces.reserve(_compiledConcepts.conceptCount());
+        for (size_t id = 0; id < _compiledConcepts.conceptCount(); ++id) {
+          _surfaces.push_back(_characters.copy(_compiledConcepts.concept(id)));
+        }
+
+        _compiledConcepts.forEach([this](const typename CompiledDictionary<KeyHash>::Entry& entry) {
+          _concepts[_characters.copy(entry.first)] = entry.second;
+        });
+
+        _compiledConcepts.close();
+      }
 
-    HashTable<Vector<char>, std::pair<String<>, Vector<size_t, 1> > > _concepts;
+      if (!_frozen) return;
+
+      _frozenConcepts.forEach([this](std::pair<Key, Value>& entry) {
+        _concepts[entry.first] = std::move(entry.second);
+      });
+
+      _frozenConcepts.clear();
+      _frozen = false;
+    }
+
+    Dictionary<Key, Value, DEFAULT_SMALL_HASHTABLE_BUCKET_COUNT, KeyHash> _concepts;
+
+    /// The dictionary once frozen
+    PerfectHashTable<Key, Value, KeyHash> _frozenConcepts;
+    bool _frozen;
+
+    /// false if the concept file of the constructor could not be read
+    bool _loaded;
+
+    /// The dictionary mapped from a compiled file
+    CompiledDictionary<KeyHash> _compiledConcepts;
+
+    /// Concepts in their original case, by ID, viewing _characters
+    Vector<View<char> > _surfaces;
+
+    /// Characters of the keys and original case forms
+    Arena _characters;
+
+    /// Powers of the rolling hash base, up to the largest concept word count
+    Vector<size_t> _basePowers;
+
+    /// Length of the longest key, in bytes: no longer word can be part of a concept
+    size_t _maxKeyLength;
   };
 
+  /// Concept extractor over a chained Hash table
+  using ConceptExtractor = BasicConceptExtractor<>;
+
+  /// Concept extractor over an open-addressing Hash table
+  using FlatConceptExtractor = BasicConceptExtractor<FlatHashTable>;
+
+  /// Concept extractor separating words by any white space, double quotes and brackets
+  using ExtendedConceptExtractor = BasicConceptExtractor<HashTable, ExtendedTextPolicy>;
+
+  /// Concept extractor lowercasing UTF-8 letters
+  using UnicodeConceptExtractor = BasicConceptExtractor<HashTable, UnicodeTextPolicy>;
+
+  /// Concept extractor lowercasing UTF-8 letters and ignoring their diacritics
+  using AccentInsensitiveConceptExtractor = BasicConceptExtractor<HashTable, AccentInsensitiveTextPolicy>;
+
+  /// Concept extractor hashing words with a key drawn per process, against crafted collisions.
+  /// Its hashes cannot be stored, so it does not compile() dictionaries
+  using SeededConceptExtractor = BasicConceptExtractor<HashTable, DefaultTextPolicy, SipHash13>;
+
 } //end namespace Concept
 
 #endif
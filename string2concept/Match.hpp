@@ -0,0 +1,57 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_MATCH_HPP
+#define CONCEPT_MATCH_HPP
+
+#include <cstdint>
+
+namespace Concept {
+
+  /// Concepts are numbered in insertion order
+  using ConceptId = uint32_t;
+
+  /// No concept
+  const ConceptId NO_CONCEPT = UINT32_MAX;
+
+  /**
+  * A concept found in an input text
+  */
+  struct Match {
+    uint32_t  begin;     ///< Offset of the first character in the input text
+    uint32_t  end;       ///< Offset past the last character in the input text
+    uint32_t  wordIndex; ///< Index of the first word among the normalized input words
+    ConceptId conceptId; ///< The concept, whose original case form is concept(conceptId)
+  };
+
+} // end namespace Concept
+
+#endif
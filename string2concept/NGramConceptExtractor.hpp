@@ -0,0 +1,450 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_NGRAM_EXTRACTOR_HPP
+#define CONCEPT_NGRAM_EXTRACTOR_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+#include "ConceptExtractor.hpp"
+#include "core/Bits.hpp"
+#include "core/FlatHashTable.hpp"
+#include "core/Hash.hpp"
+#include "core/String.hpp"
+#include "core/Vector.hpp"
+#include "core/View.hpp"
+#include "Match.hpp"
+#include "Normalizer.hpp"
+#include "Words.hpp"
+
+namespace Concept {
+
+  /**
+  * Concept extractor matching sequences of word IDs rather than byte strings.
+  * Every distinct dictionary word is interned once in a vocabulary, with a dense integer ID.
+  * Concepts are stored as word ID sequences:
+  * -# the sequences of all concepts are pooled in a single array
+  * -# the n-gram table is an open-addressing table of concept IDs, tagged with 32 bits of the sequence hash
+  * -# every word ID owns a bitmask of the word counts of the concepts starting with that word
+  *
+  * Input words are mapped to word IDs once. A word missing from the vocabulary cannot belong to any concept,
+  * so it is skipped at once, and candidate concepts stop before it.
+  * Candidates are hashed from prefix hashes of the word IDs, then compared as integer sequences.
+  *
+  * Concepts have at most MAX_CONCEPT_WORD_COUNT words. Longer concepts are ignored.
+  */
+  class NGramConceptExtractor {
+
+  public:
+
+    static const size_t MAX_CONCEPT_WORD_COUNT = 64;
+
+    using ConceptId = Concept::ConceptId;
+    using Match     = Concept::Match;
+
+    /// Vocabulary words are numbered in insertion order
+    using WordId = uint32_t;
+
+    /// The ID of input words missing from the vocabulary
+    static const WordId UNKNOWN_WORD = UINT32_MAX;
+
+    /**
+    * Default constructor: no concepts
+    */
+    NGramConceptExtractor() : _ngramCount(0) {
+      initialize();
+    }
+
+    /**
+    * Construct concepts from list of null-terminated strings
+    */
+    NGramConceptExtractor(std::initializer_list<const char*> conceptList) : _ngramCount(0) {
+      initialize();
+      for (auto& concept : conceptList) addConcept(concept);
+    }
+
+    /**
+    * Construct concepts from a concept list file, with one concept per line
+    */
+    NGramConceptExtractor(const char* conceptFilePath) : _ngramCount(0) {
+      initialize();
+
+      std::ifstream conceptFile(conceptFilePath);
+
+      // Lines of any length, with LF or CRLF line breaks
+      for (std::string concept; std::getline(conceptFile, concept); ) {
+        if (!concept.empty() && concept[concept.size() - 1] == '\r') concept.resize(concept.size() - 1);
+        addConcept(concept.c_str());
+      }
+    }
+
+    /**
+    * Insert a concept
+    */
+    void addConcept(const char* concept) {
+      Vector<char> key(concept, strlen(concept));
+      ConceptExtractor::lowerCase(key);
+
+      Words keyWords(key, false);
+      size_t wordCount = keyWords.length();
+      if (wordCount == 0 || wordCount > MAX_CONCEPT_WORD_COUNT) return;
+
+      Vector<WordId> ids;
+      ids.reserve(wordCount);
+      for (size_t i = 0; i < wordCount; ++i) ids.push_back(intern(keyWords.word(i)));
+
+      // A concept added again in another case keeps its ID
+      size_t hash = hashNGram(ids.data(), wordCount);
+      ConceptId id = findNGram(ids.data(), wordCount, hash);
+      if (id != NO_CONCEPT) {
+        _surfaces[id] = concept;
+        return;
+      }
+
+      id = static_cast<ConceptId>(_concepts.size());
+
+      ConceptSpan span;
+      span.offset = static_cast<uint32_t>(_ngramWords.size());
+      span.wordCount = static_cast<uint32_t>(wordCount);
+
+      _ngramWords += ids;
+
+      _concepts.push_back(span);
+
+      _surfaces.push_back(concept);
+
+      insertNGram(id, hash);
+
+      _startMasks[ids[0]] |= static_cast<uint64_t>(1) << (wordCount - 1);
+    }
+
+    /**
+    * N-gram tables are always ready for lookups: nothing to freeze
+    * @return true
+    */
+    bool freeze() {
+      return true;
+    }
+
+    /**
+    * @return true
+    */
+    bool frozen() const {
+      return true;
+    }
+
+    /**
+    * @return the number of concepts
+    */
+    size_t conceptCount() const {
+      return _concepts.size();
+    }
+
+    /**
+    * @return the number of distinct dictionary words
+    */
+    size_t vocabularySize() const {
+      return _startMasks.size();
+    }
+
+    /**
+    * @param id a concept ID, lower than conceptCount()
+    * @return the concept in its original case
+    */
+    View<char> concept(ConceptId id) const {
+      return View<char>(_surfaces[id].c_str(), _surfaces[id].length());
+    }
+
+    /**
+    * Extract concepts from an input text
+    * @param input The input text
+    * @return a vector of concepts
+    */
+    template <size_t N>
+    Vector<String<> > get(const String<N>& input) const {
+      Vector<char, N> lcInput(input);
+
+      Vector<uint32_t> boundaries;
+      Normalizer::normalize(lcInput, nullptr, &boundaries);
+
+      Words words(lcInput, boundaries);
+
+      Vector<String<> > result;
+      extract(words, [this, &result](size_t, size_t, ConceptId id) { result.push_back(concept(id)); });
+
+      return result;
+    }
+
+    /**
+    * Find the concepts of an input text with their positions
+    * @param input The input text
+    * @return the matches, ordered by first word then by word count
+    */
+    template <size_t N>
+    Vector<Match> matches(const String<N>& input) const {
+      Vector<Match> result;
+      forEachMatch(input, [&result](const Match& match) { result.push_back(match); });
+
+      return result;
+    }
+
+    /**
+    * Visit the concepts of an input text with their positions.
+    * Matches are not stored, and concepts are not copied.
+    * @param input The input text
+    * @param visit a function taking a constant Match reference, ordered by first word then by word count
+    */
+    template <size_t N, typename Visitor>
+    void forEachMatch(const String<N>& input, Visitor visit) const {
+      Vector<char, N> lcInput(input);
+
+      // positions[i] is the input offset of the i-th normalized character
+      Vector<uint32_t> positions, boundaries;
+      Normalizer::normalize(lcInput, &positions, &boundaries);
+
+      Words words(lcInput, boundaries);
+
+      extract(words, [&](size_t first, size_t wordCount, ConceptId id) {
+        size_t last = first + wordCount - 1;
+
+        Match match;
+        match.begin     = positions[words.offset(first)];
+        match.end       = positions[words.offset(last) + words.wordLength(last) - 1] + 1;
+        match.wordIndex = static_cast<uint32_t>(first);
+        match.conceptId = id;
+
+        visit(static_cast<const Match&>(match));
+      });
+    }
+
+  private:
+
+    using WordHash = RollingWordHash<>;
+
+    static const size_t INITIAL_SLOT_COUNT = 16;
+
+    /**
+    * The word ID sequence of a concept in the pool
+    */
+    struct ConceptSpan {
+      uint32_t offset;
+      uint32_t wordCount;
+    };
+
+    /**
+    * N-gram table slot
+    */
+    struct Slot {
+      uint32_t  tag;
+      ConceptId conceptId;
+    };
+
+    /**
+    * Map the input words to word IDs, then lookup the concepts starting at every word
+    * @param words the normalized input words
+    * @param visit a function taking the first word index, the word count and the ID of every concept
+    */
+    template <typename Visitor>
+    void extract(const Words& words, Visitor visit) const {
+      size_t wordCount = words.length();
+
+      // Map every input word once. prefixHashes[i] is the hash of the i first word IDs
+      Vector<WordId> ids;
+      ids.resize(wordCount);
+
+      Vector<size_t> prefixHashes;
+      prefixHashes.resize(wordCount + 1);
+      prefixHashes[0] = 0;
+
+      for (size_t i = 0; i < wordCount; ++i) {
+        auto entry = _vocabulary.find(words.word(i));
+        if (entry != _vocabulary.end()) ids[i] = entry->second;
+        else ids[i] = UNKNOWN_WORD;
+
+        prefixHashes[i + 1] = WordHash::combine(prefixHashes[i], hashWord(ids[i]));
+      }
+
+      // End of the run of known words including the current word
+      size_t knownEnd = 0;
+
+      for (size_t first = 0; first < wordCount; ++first) {
+        if (ids[first] == UNKNOWN_WORD) continue;
+
+        if (knownEnd <= first) {
+          for (knownEnd = first + 1; knownEnd < wordCount && ids[knownEnd] != UNKNOWN_WORD; ++knownEnd);
+        }
+
+        // Word counts of the concepts starting with that word, in increasing order
+        for (uint64_t mask = _startMasks[ids[first]]; mask != 0; mask &= mask - 1) {
+          size_t count = countTrailingZeros(mask) + 1;
+
+          // Concepts cannot span unknown words
+          if (first + count > knownEnd) break;
+
+          size_t hash = WordHash::span(prefixHashes[first], prefixHashes[first + count], _basePowers[count]);
+          ConceptId id = findNGram(ids.data() + first, count, hash);
+          if (id != NO_CONCEPT) visit(first, count, id);
+        }
+      }
+    }
+
+    /**
+    * Start with an empty n-gram table
+    */
+    void initialize() {
+      _slots.resize(INITIAL_SLOT_COUNT);
+      for (auto& slot : _slots) slot.conceptId = NO_CONCEPT;
+
+      _basePowers.reserve(MAX_CONCEPT_WORD_COUNT + 1);
+      _basePowers.push_back(1);
+      while (_basePowers.size() <= MAX_CONCEPT_WORD_COUNT) {
+        _basePowers.push_back(*_basePowers.last() * WordHash::BASE);
+      }
+    }
+
+    /**
+    * @return the ID of a dictionary word, numbering it if new
+    */
+    WordId intern(const View<char>& word) {
+      auto entry = _vocabulary.find(word);
+      if (entry != _vocabulary.end()) return entry->second;
+
+      WordId id = static_cast<WordId>(_startMasks.size());
+      _vocabulary[Vector<char>(word.data(), word.size())] = id;
+
+      _startMasks.push_back(0);
+
+      return id;
+    }
+
+    /**
+    * @return the ID of the concept with that word ID sequence, or NO_CONCEPT
+    */
+    ConceptId findNGram(const WordId* ids, size_t count, size_t hash) const {
+      uint32_t tag = static_cast<uint32_t>(hash);
+      size_t mask = _slots.size() - 1;
+
+      for (size_t i = static_cast<size_t>(mixBits(hash)) & mask; ; i = (i + 1) & mask) {
+        const Slot& slot = _slots[i];
+        if (slot.conceptId == NO_CONCEPT) return NO_CONCEPT;
+
+        if (slot.tag == tag) {
+          const ConceptSpan& span = _concepts[slot.conceptId];
+          if (span.wordCount == count && memcmp(_ngramWords.data() + span.offset, ids, count * sizeof(WordId)) == 0) {
+            return slot.conceptId;
+          }
+        }
+      }
+    }
+
+    /**
+    * Insert a concept in the n-gram table, keeping it at most half full
+    */
+    void insertNGram(ConceptId id, size_t hash) {
+      if (2 * (_ngramCount + 1) > _slots.size()) {
+        Vector<Slot> slots;
+        slots.resize(2 * _slots.size());
+        for (auto& slot : slots) slot.conceptId = NO_CONCEPT;
+
+        for (size_t i = 0; i < _slots.size(); ++i) {
+          if (_slots[i].conceptId == NO_CONCEPT) continue;
+
+          const ConceptSpan& span = _concepts[_slots[i].conceptId];
+          place(slots, _slots[i].conceptId, hashNGram(_ngramWords.data() + span.offset, span.wordCount));
+        }
+
+        _slots = std::move(slots);
+      }
+
+      place(_slots, id, hash);
+      ++_ngramCount;
+    }
+
+    /**
+    * Store a concept ID in the first empty slot of its probe sequence
+    */
+    static void place(Vector<Slot>& slots, ConceptId id, size_t hash) {
+      size_t mask = slots.size() - 1;
+      size_t i = static_cast<size_t>(mixBits(hash)) & mask;
+      while (slots[i].conceptId != NO_CONCEPT) i = (i + 1) & mask;
+
+      slots[i].tag = static_cast<uint32_t>(hash);
+      slots[i].conceptId = id;
+    }
+
+    /**
+    * @return the hash of a word ID sequence, equal to the span of its prefix hashes
+    */
+    static size_t hashNGram(const WordId* ids, size_t count) {
+      size_t hash = 0;
+      for (size_t i = 0; i < count; ++i) hash = WordHash::combine(hash, hashWord(ids[i]));
+
+      return hash;
+    }
+
+    /**
+    * @return the hash of a word ID
+    */
+    static size_t hashWord(WordId id) {
+      return static_cast<size_t>(mixBits(static_cast<uint64_t>(id) + 1));
+    }
+
+    /// Dictionary words to word IDs
+    FlatHashTable<Vector<char>, WordId> _vocabulary;
+
+    /// Bitmasks of the word counts of the concepts starting with a word, by word ID
+    Vector<uint64_t> _startMasks;
+
+    /// Word ID sequences of all concepts
+    Vector<WordId> _ngramWords;
+
+    /// Concept sequences in the pool, by concept ID
+    Vector<ConceptSpan> _concepts;
+
+    /// Concepts in their original case, by concept ID
+    Vector<String<> > _surfaces;
+
+    /// The n-gram table
+    Vector<Slot> _slots;
+    size_t       _ngramCount;
+
+    /// Powers of the rolling hash base, up to the largest concept word count
+    Vector<size_t> _basePowers;
+  };
+
+} //end namespace Concept
+
+#endif
@@ -0,0 +1,484 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_NORMALIZER_HPP
+#define CONCEPT_NORMALIZER_HPP
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "core/Bits.hpp"
+#include "core/Cpu.hpp"
+#include "core/Vector.hpp"
+#include "TextPolicy.hpp"
+#include "UnicodeFolder.hpp"
+
+#if defined(CONCEPT_CPU_X86)
+#include <immintrin.h>
+#endif
+
+namespace Concept {
+
+  /**
+  * Text normalization fused in a single pass: characters are folded, punctuation is removed,
+  * separators followed by a separator, by punctuation or by the text end are removed,
+  * the remaining separators are written as spaces, and the boundaries of the words are reported on the way.
+  * Classes and folding come from the Policy template parameter, a TextPolicy.
+  *
+  * Blocks of 16 (SSE4.2) or 32 (AVX2) characters are classified with two nibble lookups,
+  * then the kept characters are packed with byte shuffles looked up by 8-bit masks.
+  * The kernel is chosen once from the running CPU, with a scalar fallback for other CPUs and the text tail.
+  * Vector kernels require the policy to fold ASCII letters only, and its classes to be
+  * unions of at most 8 sets of (high nibble, low nibble) pairs, as the default ones are.
+  * Other policies always run the scalar kernel.
+  * Policies folding UTF-8 characters run the UnicodeFolder beforehand.
+  */
+  template <typename Policy = DefaultTextPolicy>
+  class BasicNormalizer {
+
+  public:
+
+    /// Positions and boundaries are 32-bit offsets: texts reporting them are limited to 4 GiB
+    static const size_t MAX_TEXT_SIZE = std::numeric_limits<uint32_t>::max();
+
+    enum Kernel {
+      SCALAR, ///< One character at a time, on any CPU
+      SSE42,  ///< 16 characters at a time
+      AVX2    ///< 32 characters at a time
+    };
+
+    /**
+    * @return the fastest kernel supported by the running CPU and the policy
+    */
+    static Kernel bestKernel() {
+      static const Kernel kernel = (supports(AVX2) ? AVX2 : (supports(SSE42) ? SSE42 : SCALAR));
+      return kernel;
+    }
+
+    /**
+    * @return true if the running CPU and the policy support the kernel
+    */
+    static bool supports(Kernel kernel) {
+#if defined(CONCEPT_CPU_X86)
+      if (kernel != SCALAR && !vectorization().enabled) return false;
+      if (kernel == AVX2) return CpuFeatures::get().avx2 && CpuFeatures::get().sse42;
+      if (kernel == SSE42) return CpuFeatures::get().sse42;
+#endif
+      return kernel == SCALAR;
+    }
+
+    /**
+    * Normalize a text in place
+    * @param[in,out] text the text to normalize
+    * @param[out] positions if not null, the former offset of every kept character
+    * @param[out] boundaries if not null, the offset of the first character then the past-the-end offset of every word
+    * @param kernel the kernel, supported by the running CPU
+    * @throw std::length_error if positions or boundaries are requested for a text over MAX_TEXT_SIZE
+    */
+    template <size_t N>
+    static void normalize(Vector<char, N>& text, Vector<uint32_t>* positions = nullptr,
+                          Vector<uint32_t>* boundaries = nullptr, Kernel kernel = bestKernel()) {
+      if ((positions || boundaries) && text.size() > MAX_TEXT_SIZE) {
+        throw std::length_error("Normalized text exceeds 32-bit offsets");
+      }
+
+      if (positions) positions->resize(text.size());
+
+      // At most one boundary per character, plus the end of the last word: no reallocation while normalizing
+      if (boundaries) {
+        boundaries->resize(0);
+        boundaries->reserve(text.size() + 1);
+      }
+
+      size_t size = text.size();
+
+      // UTF-8 characters are folded first, tracking their offsets apart
+      Vector<uint32_t> foldedPositions;
+      bool unicode = (Policy::unicodeFolding() != NO_UNICODE_FOLDING);
+
+      if (unicode) {
+        if (positions) foldedPositions.resize(size);
+        size = UnicodeFolder::fold(text.data(), size, Policy::unicodeFolding(), positions ? foldedPositions.data() : nullptr);
+      }
+
+      size = normalize(text.data(), size, positions ? positions->data() : nullptr, boundaries, kernel);
+
+      text.resize(size);
+      if (positions) {
+        positions->resize(size);
+        if (unicode) for (auto& position : *positions) position = foldedPositions[position];
+      }
+    }
+
+    /**
+    * Normalize characters in place
+    * @return the normalized size
+    */
+    static size_t normalize(char* text, size_t size, uint32_t* positions, Vector<uint32_t>* boundaries, Kernel kernel) {
+      State state;
+      state.out = 0;
+      state.inWord = false;
+
+      size_t i = 0;
+
+#if defined(CONCEPT_CPU_X86)
+      if (kernel != SCALAR && vectorization().enabled) {
+        if (kernel == AVX2) i = avx2(text, size, positions, boundaries, state);
+        i = sse42(text, size, i, positions, boundaries, state);
+      }
+#else
+      (void)kernel;
+#endif
+
+      scalar(text, size, i, positions, boundaries, state);
+
+      if (boundaries && state.inWord) boundaries->push_back(static_cast<uint32_t>(state.out));
+
+      return state.out;
+    }
+
+    /**
+    * @return true if ch is a punctuation character
+    */
+    static bool isPunctuation(char ch) {
+      return Policy::isPunctuation(ch);
+    }
+
+  private:
+
+    /**
+    * Progress shared by the kernels
+    */
+    struct State {
+      size_t out;    ///< The number of characters kept so far
+      bool   inWord; ///< true if the last character kept belongs to a word
+    };
+
+    /**
+    * Normalize one character at a time, from the i-th character to the end
+    */
+    static void scalar(char* text, size_t size, size_t i, uint32_t* positions, Vector<uint32_t>* boundaries, State& state) {
+      for (; i < size; ++i) {
+        uint8_t characterClass = Policy::classOf(text[i]);
+
+        if (characterClass & PUNCTUATION) continue;
+
+        bool separator = (characterClass & SEPARATOR) != 0;
+        if (separator && (i == 0 || i + 1 == size || Policy::classOf(text[i + 1]) != 0)) continue;
+
+        // A word starts at a character after a separator, and ends at a separator after a character
+        if (boundaries && separator == state.inWord) {
+          boundaries->push_back(static_cast<uint32_t>(state.out));
+          state.inWord = !separator;
+        }
+
+        text[state.out] = separator ? ' ' : Policy::fold(text[i]);
+        if (positions) positions[state.out] = static_cast<uint32_t>(i);
+        ++state.out;
+      }
+    }
+
+    /**
+    * @param punctuation the punctuation mask of a block
+    * @param separators the separator mask of the block
+    * @param width the number of characters in the block
+    * @param next the character following the block
+    * @param i the block offset
+    * @return the mask of the characters removed from the block
+    */
+    static uint32_t dropped(uint32_t punctuation, uint32_t separators, unsigned width, char next, size_t i) {
+      uint32_t nextRemoving = (Policy::classOf(next) != 0) ? 1 : 0;
+
+      // A separator goes when the next character is punctuation or a separator
+      uint32_t result = punctuation | (separators & (((punctuation | separators) >> 1) | (nextRemoving << (width - 1))));
+      if (i == 0) result |= separators & 1;
+
+      return result;
+    }
+
+#if defined(CONCEPT_CPU_X86)
+
+    /**
+    * Nibble tables classifying 16 or 32 characters at once: a character belongs to a class
+    * if the groups of its low nibble and of its high nibble share a group of the class
+    */
+    struct Vectorization {
+      bool    enabled;           ///< false if the policy cannot be vectorized
+      uint8_t low[16];           ///< The groups of every low nibble
+      uint8_t high[16];          ///< The groups of every high nibble
+      uint8_t separatorGroups;   ///< The groups of separators
+      uint8_t punctuationGroups; ///< The groups of punctuation
+
+      Vectorization() : enabled(false), separatorGroups(0), punctuationGroups(0) {
+        for (unsigned nibble = 0; nibble < 16; ++nibble) low[nibble] = high[nibble] = 0;
+
+        // Vector kernels fold ASCII letters, classify before folding, and find words between spaces
+        if (!Policy::isSeparator(' ')) return;
+
+        for (unsigned ch = 0; ch < 256; ++ch) {
+          char c = static_cast<char>(ch);
+          char lower = (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch + ('a' - 'A')) : c;
+          if (Policy::fold(c) != lower || Policy::classOf(c) != Policy::classOf(lower)) return;
+        }
+
+        // High nibbles sharing the same low nibbles form a group
+        unsigned groupCount = 0;
+        const uint8_t classes[] = { SEPARATOR, PUNCTUATION };
+
+        for (auto characterClass : classes) {
+          uint16_t lows[16] = { 0 };
+          for (unsigned ch = 0; ch < 256; ++ch) {
+            if (Policy::classOf(static_cast<char>(ch)) & characterClass) lows[ch >> 4] |= static_cast<uint16_t>(1u << (ch & 15));
+          }
+
+          bool grouped[16] = { false };
+          for (unsigned highNibble = 0; highNibble < 16; ++highNibble) {
+            if (lows[highNibble] == 0 || grouped[highNibble]) continue;
+            if (groupCount == 8) return;
+
+            uint8_t group = static_cast<uint8_t>(1u << groupCount++);
+            if (characterClass == SEPARATOR) {
+              separatorGroups |= group;
+            } else {
+              punctuationGroups |= group;
+            }
+
+            for (unsigned other = highNibble; other < 16; ++other) {
+              if (lows[other] != lows[highNibble]) continue;
+              grouped[other] = true;
+              high[other] |= group;
+            }
+
+            for (unsigned lowNibble = 0; lowNibble < 16; ++lowNibble) {
+              if (lows[highNibble] & (1u << lowNibble)) low[lowNibble] |= group;
+            }
+          }
+        }
+
+        enabled = true;
+      }
+    };
+
+    static const Vectorization& vectorization() {
+      static const Vectorization tables;
+      return tables;
+    }
+
+    /**
+    * Byte shuffles packing the kept characters of 8, by 8-bit mask of kept characters
+    */
+    struct CompactionTable {
+      uint8_t shuffles[256][8]; ///< The offsets of the kept characters, then 0x80 which zeroes bytes
+      uint8_t counts[256];      ///< The number of kept characters
+
+      CompactionTable() {
+        for (unsigned mask = 0; mask < 256; ++mask) {
+          unsigned count = 0;
+          for (unsigned bit = 0; bit < 8; ++bit) {
+            if (mask & (1u << bit)) shuffles[mask][count++] = static_cast<uint8_t>(bit);
+          }
+
+          counts[mask] = static_cast<uint8_t>(count);
+          for (; count < 8; ++count) shuffles[mask][count] = 0x80;
+        }
+      }
+    };
+
+    static const CompactionTable& compactionTable() {
+      static const CompactionTable table;
+      return table;
+    }
+
+    /**
+    * @return the groups of 16 characters
+    */
+    CONCEPT_TARGET("sse4.2,popcnt")
+    static __m128i groups(__m128i block, __m128i low, __m128i high) {
+      __m128i nibbles = _mm_set1_epi8(0x0F);
+      return _mm_and_si128(_mm_shuffle_epi8(low, _mm_and_si128(block, nibbles)),
+                           _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(block, 4), nibbles)));
+    }
+
+    /**
+    * @return 0xFF for the characters having none of the groups, 0 for the others
+    */
+    CONCEPT_TARGET("sse4.2,popcnt")
+    static __m128i lacking(__m128i groups, uint8_t classGroups) {
+      return _mm_cmpeq_epi8(_mm_and_si128(groups, _mm_set1_epi8(static_cast<char>(classGroups))), _mm_setzero_si128());
+    }
+
+    /**
+    * @return the block with ASCII letters lowercased
+    */
+    CONCEPT_TARGET("sse4.2,popcnt")
+    static __m128i lowerCase(__m128i block) {
+      __m128i letters = _mm_sub_epi8(block, _mm_set1_epi8('A'));
+      __m128i upper = _mm_cmpeq_epi8(_mm_min_epu8(letters, _mm_set1_epi8(25)), letters);
+      return _mm_add_epi8(block, _mm_and_si128(upper, _mm_set1_epi8('a' - 'A')));
+    }
+
+    /**
+    * Pack the kept characters of a block of 16, with their former offsets and the word boundaries
+    * @param lower the folded block, with separators as spaces
+    * @param kept the mask of kept characters
+    * @param i the block offset. Characters are written at state.out, up to i + 16
+    */
+    CONCEPT_TARGET("sse4.2,popcnt")
+    static void compact(const CompactionTable& table, __m128i lower, uint32_t kept, char* text, size_t i,
+                        uint32_t* positions, Vector<uint32_t>* boundaries, State& state) {
+      unsigned low = kept & 0xFF, high = kept >> 8;
+      unsigned lowCount = table.counts[low], highCount = table.counts[high];
+
+      // Both halves are packed by a single shuffle, then stored one after the other
+      __m128i shuffle = _mm_unpacklo_epi64(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffles[low])),
+        _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.shuffles[high])), _mm_set1_epi8(8)));
+
+      __m128i packed = _mm_shuffle_epi8(lower, shuffle);
+
+      char* out = text + state.out;
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out + lowCount), _mm_unpackhi_epi64(packed, packed));
+
+      if (positions) {
+        __m128i offsets = _mm_shuffle_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), shuffle);
+        __m128i base = _mm_set1_epi32(static_cast<int>(i));
+
+        __m128i* lowOut = reinterpret_cast<__m128i*>(positions + state.out);
+        _mm_storeu_si128(lowOut,     _mm_add_epi32(base, _mm_cvtepu8_epi32(offsets)));
+        _mm_storeu_si128(lowOut + 1, _mm_add_epi32(base, _mm_cvtepu8_epi32(_mm_srli_si128(offsets, 4))));
+
+        __m128i* highOut = reinterpret_cast<__m128i*>(positions + state.out + lowCount);
+        _mm_storeu_si128(highOut,     _mm_add_epi32(base, _mm_cvtepu8_epi32(_mm_srli_si128(offsets, 8))));
+        _mm_storeu_si128(highOut + 1, _mm_add_epi32(base, _mm_cvtepu8_epi32(_mm_srli_si128(offsets, 12))));
+      }
+
+      unsigned count = lowCount + highCount;
+
+      if (boundaries && count > 0) {
+        uint32_t halves = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(packed, _mm_set1_epi8(' '))));
+
+        uint32_t separators = (halves & ((1u << lowCount) - 1)) | (((halves >> 8) & ((1u << highCount) - 1)) << lowCount);
+        uint32_t inWord = ~separators & ((1u << count) - 1);
+        uint32_t previous = (inWord << 1) | (state.inWord ? 1 : 0);
+
+        for (uint32_t events = (inWord & ~previous) | (separators & previous); events != 0; events &= events - 1) {
+          boundaries->push_back(static_cast<uint32_t>(state.out + countTrailingZeros(events)));
+        }
+
+        state.inWord = ((inWord >> (count - 1)) & 1) != 0;
+      }
+
+      state.out += count;
+    }
+
+    /**
+    * Normalize blocks of 16 characters, from the i-th character
+    * @return the offset of the first character left
+    */
+    CONCEPT_TARGET("sse4.2,popcnt")
+    static size_t sse42(char* text, size_t size, size_t i, uint32_t* positions, Vector<uint32_t>* boundaries, State& state) {
+      const CompactionTable& table = compactionTable();
+      const Vectorization& tables = vectorization();
+
+      __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.low));
+      __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.high));
+
+      // The character following a block tells whether a last separator is kept
+      for (; i + 16 < size; i += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i blockGroups = groups(block, low, high);
+
+        __m128i notPunctuation = lacking(blockGroups, tables.punctuationGroups);
+        __m128i notSeparator = lacking(blockGroups, tables.separatorGroups);
+
+        uint32_t kept = ~dropped(~static_cast<uint32_t>(_mm_movemask_epi8(notPunctuation)) & 0xFFFF,
+                                 ~static_cast<uint32_t>(_mm_movemask_epi8(notSeparator)) & 0xFFFF, 16, text[i + 16], i) & 0xFFFF;
+
+        __m128i lower = _mm_blendv_epi8(_mm_set1_epi8(' '), lowerCase(block), notSeparator);
+        compact(table, lower, kept, text, i, positions, boundaries, state);
+      }
+
+      return i;
+    }
+
+    /**
+    * Normalize blocks of 32 characters, from the first character
+    * @return the offset of the first character left
+    */
+    CONCEPT_TARGET("avx2,sse4.2,popcnt")
+    static size_t avx2(char* text, size_t size, uint32_t* positions, Vector<uint32_t>* boundaries, State& state) {
+      const CompactionTable& table = compactionTable();
+      const Vectorization& tables = vectorization();
+
+      __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.low)));
+      __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.high)));
+      __m256i nibbles = _mm256_set1_epi8(0x0F);
+
+      size_t i = 0;
+      for (; i + 32 < size; i += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+
+        __m256i letters = _mm256_sub_epi8(block, _mm256_set1_epi8('A'));
+        __m256i upper = _mm256_cmpeq_epi8(_mm256_min_epu8(letters, _mm256_set1_epi8(25)), letters);
+        __m256i lower = _mm256_add_epi8(block, _mm256_and_si256(upper, _mm256_set1_epi8('a' - 'A')));
+
+        __m256i blockGroups = _mm256_and_si256(_mm256_shuffle_epi8(low, _mm256_and_si256(block, nibbles)),
+                                               _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibbles)));
+
+        __m256i notPunctuation = _mm256_cmpeq_epi8(
+          _mm256_and_si256(blockGroups, _mm256_set1_epi8(static_cast<char>(tables.punctuationGroups))), _mm256_setzero_si256());
+        __m256i notSeparator = _mm256_cmpeq_epi8(
+          _mm256_and_si256(blockGroups, _mm256_set1_epi8(static_cast<char>(tables.separatorGroups))), _mm256_setzero_si256());
+
+        uint32_t kept = ~dropped(~static_cast<uint32_t>(_mm256_movemask_epi8(notPunctuation)),
+                                 ~static_cast<uint32_t>(_mm256_movemask_epi8(notSeparator)), 32, text[i + 32], i);
+
+        lower = _mm256_blendv_epi8(_mm256_set1_epi8(' '), lower, notSeparator);
+
+        // Packed characters never pass the block being read, so both halves are written in place
+        compact(table, _mm256_castsi256_si128(lower), kept & 0xFFFF, text, i, positions, boundaries, state);
+        compact(table, _mm256_extracti128_si256(lower, 1), kept >> 16, text, i + 16, positions, boundaries, state);
+      }
+
+      return i;
+    }
+
+#endif
+  };
+
+  /// Normalizer of the default text policy
+  using Normalizer = BasicNormalizer<>;
+
+} // end namespace Concept
+
+#endif
@@ -0,0 +1,212 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_TEXTPOLICY_HPP
+#define CONCEPT_TEXTPOLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Concept {
+
+  /**
+  * Character classes, as bits of TextPolicy::classOf()
+  */
+  enum CharacterClass : uint8_t {
+    SEPARATOR   = 1, ///< Separates words
+    PUNCTUATION = 2  ///< Removed from texts
+  };
+
+  /**
+  * Folding of UTF-8 characters beyond ASCII, as TextPolicy::unicodeFolding()
+  */
+  enum UnicodeFolding {
+    NO_UNICODE_FOLDING,    ///< Bytes beyond ASCII are kept as is
+    UNICODE_CASE_FOLDING,  ///< Latin, Greek and Cyrillic letters are lowercased
+    UNICODE_ACCENT_FOLDING ///< Letters are lowercased and stripped of their diacritics, combining marks are removed
+  };
+
+  /**
+  * Text rules of the former implementation: words are separated by spaces and null characters,
+  * punctuation is , ; . ! ? and only ASCII letters are lowercased
+  */
+  struct AsciiTextRules {
+    static constexpr bool isSeparator(unsigned char ch) {
+      return ch == ' ' || ch == 0;
+    }
+
+    static constexpr bool isPunctuation(unsigned char ch) {
+      return ch == ',' || ch == ';' || ch == '.' || ch == '!' || ch == '?';
+    }
+
+    static constexpr unsigned char fold(unsigned char ch) {
+      return (ch >= 'A' && ch <= 'Z') ? static_cast<unsigned char>(ch + ('a' - 'A')) : ch;
+    }
+
+    static constexpr UnicodeFolding UNICODE_FOLDING = NO_UNICODE_FOLDING;
+  };
+
+  /**
+  * Text rules separating words by any ASCII white space, double quotes and brackets, and removing colons too.
+  * Apostrophes stay within words, as in "o'clock".
+  */
+  struct ExtendedTextRules : AsciiTextRules {
+    static constexpr bool isSeparator(unsigned char ch) {
+      return ch == ' ' || ch == 0 || (ch >= '\t' && ch <= '\r') || ch == '"' || ch == '`' ||
+             ch == '(' || ch == ')' || ch == '[' || ch == ']' || ch == '{' || ch == '}';
+    }
+
+    static constexpr bool isPunctuation(unsigned char ch) {
+      return AsciiTextRules::isPunctuation(ch) || ch == ':';
+    }
+  };
+
+  /**
+  * Text rules of the former implementation, also lowercasing UTF-8 Latin, Greek and Cyrillic letters
+  */
+  struct UnicodeTextRules : AsciiTextRules {
+    static constexpr UnicodeFolding UNICODE_FOLDING = UNICODE_CASE_FOLDING;
+  };
+
+  /**
+  * Text rules of the former implementation, also lowercasing UTF-8 letters and stripping their diacritics,
+  * so that "Caf\xC3\xA9", "CAFE" and "cafe" are the same word
+  */
+  struct AccentInsensitiveTextRules : AsciiTextRules {
+    static constexpr UnicodeFolding UNICODE_FOLDING = UNICODE_ACCENT_FOLDING;
+  };
+
+  namespace TextTables {
+
+    template <size_t... I>
+    struct Indices {};
+
+    template <size_t N, size_t... I>
+    struct MakeIndices : MakeIndices<N - 1, N - 1, I...> {};
+
+    template <size_t... I>
+    struct MakeIndices<0, I...> {
+      using Type = Indices<I...>;
+    };
+
+    template <typename Rules>
+    constexpr uint8_t classify(unsigned char ch) {
+      return static_cast<uint8_t>((Rules::isSeparator(ch) ? SEPARATOR : 0) | (Rules::isPunctuation(ch) ? PUNCTUATION : 0));
+    }
+
+    /**
+    * The tables of every byte value, evaluated at compile time
+    */
+    template <typename Rules, typename Indices>
+    struct Tables;
+
+    template <typename Rules, size_t... I>
+    struct Tables<Rules, Indices<I...> > {
+      static constexpr uint8_t CLASSES[sizeof...(I)] = { classify<Rules>(static_cast<unsigned char>(I))... };
+      static constexpr char    FOLDS[sizeof...(I)]   = { static_cast<char>(Rules::fold(static_cast<unsigned char>(I)))... };
+    };
+
+    template <typename Rules, size_t... I>
+    constexpr uint8_t Tables<Rules, Indices<I...> >::CLASSES[sizeof...(I)];
+
+    template <typename Rules, size_t... I>
+    constexpr char Tables<Rules, Indices<I...> >::FOLDS[sizeof...(I)];
+
+  } // end namespace TextTables
+
+  /**
+  * Tokenization rules, as 256-entry tables built at compile time from a Rules class.
+  * Rules define static constexpr functions of an unsigned char:
+  * - isSeparator(ch), true if ch separates words
+  * - isPunctuation(ch), true if ch is removed from texts
+  * - fold(ch), the character compared in place of ch, e.g. its lowercase form
+  * .
+  * and a static constexpr UnicodeFolding UNICODE_FOLDING, applied to UTF-8 sequences before the tables.
+  * Classifying or folding a character then costs a single table load.
+  */
+  template <typename Rules>
+  class TextPolicy {
+
+    using Tables = TextTables::Tables<Rules, typename TextTables::MakeIndices<256>::Type>;
+
+  public:
+
+    /**
+    * @return the CharacterClass bits of ch
+    */
+    static uint8_t classOf(char ch) {
+      return Tables::CLASSES[static_cast<unsigned char>(ch)];
+    }
+
+    /**
+    * @return true if ch is a separator
+    */
+    static bool isSeparator(char ch) {
+      return (classOf(ch) & SEPARATOR) != 0;
+    }
+
+    /**
+    * @return true if ch is a punctuation character
+    */
+    static bool isPunctuation(char ch) {
+      return (classOf(ch) & PUNCTUATION) != 0;
+    }
+
+    /**
+    * @return the folded form of ch
+    */
+    static char fold(char ch) {
+      return Tables::FOLDS[static_cast<unsigned char>(ch)];
+    }
+
+    /**
+    * @return the folding of UTF-8 characters beyond ASCII
+    */
+    static UnicodeFolding unicodeFolding() {
+      return Rules::UNICODE_FOLDING;
+    }
+  };
+
+  /// The rules of the former implementation
+  using DefaultTextPolicy = TextPolicy<AsciiTextRules>;
+
+  /// White space, quote and bracket separators
+  using ExtendedTextPolicy = TextPolicy<ExtendedTextRules>;
+
+  /// UTF-8 letters lowercased
+  using UnicodeTextPolicy = TextPolicy<UnicodeTextRules>;
+
+  /// UTF-8 letters lowercased and stripped of their diacritics
+  using AccentInsensitiveTextPolicy = TextPolicy<AccentInsensitiveTextRules>;
+
+} // end namespace Concept
+
+#endif
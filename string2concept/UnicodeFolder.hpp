@@ -0,0 +1,412 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_UNICODEFOLDER_HPP
+#define CONCEPT_UNICODEFOLDER_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "core/Cpu.hpp"
+#include "core/Vector.hpp"
+#include "TextPolicy.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONCEPT_UNICODEFOLDER_SSE2
+#endif
+
+#if defined(CONCEPT_CPU_X86)
+#include <immintrin.h>
+#endif
+
+namespace Concept {
+
+  /**
+  * Folding of UTF-8 texts in place: two-byte Latin, Greek and Cyrillic letters are lowercased,
+  * and optionally stripped of their diacritics, following the Unicode decompositions.
+  * Folded characters are never longer than the original ones, e.g. "É" becomes "é" or "e", and "Æ" becomes "æ" or "ae".
+  * Other sequences, and bytes that are not valid UTF-8, are kept as is. ASCII bytes are left to the TextPolicy.
+  *
+  * Blocks of 16 (SSE2) or 32 (AVX2) ASCII bytes are detected with a single sign-bit mask and skipped,
+  * and are not even moved as long as no previous character was shortened.
+  */
+  class UnicodeFolder {
+
+  public:
+
+    /**
+    * Fold a text in place
+    * @param[in,out] text the text to fold
+    * @param folding the folding
+    * @param[out] positions if not null, the former offset of every folded byte
+    */
+    template <size_t N>
+    static void fold(Vector<char, N>& text, UnicodeFolding folding, Vector<uint32_t>* positions = nullptr) {
+      if (positions) positions->resize(text.size());
+
+      size_t size = fold(text.data(), text.size(), folding, positions ? positions->data() : nullptr);
+
+      text.resize(size);
+      if (positions) positions->resize(size);
+    }
+
+    /**
+    * Fold bytes in place
+    * @return the folded size
+    */
+    static size_t fold(char* text, size_t size, UnicodeFolding folding, uint32_t* positions) {
+      if (folding == NO_UNICODE_FOLDING) {
+        if (positions) for (size_t i = 0; i < size; ++i) positions[i] = static_cast<uint32_t>(i);
+        return size;
+      }
+
+      size_t i = 0, out = 0;
+      bool avx2 = CpuFeatures::get().avx2;
+
+      while (i < size) {
+#if defined(CONCEPT_CPU_X86)
+        if (avx2) skipAsciiAvx2(text, size, i, out, positions);
+#endif
+#if defined(CONCEPT_UNICODEFOLDER_SSE2)
+        skipAscii(text, size, i, out, positions);
+#endif
+
+        // Fold one block character by character, then look for ASCII blocks again
+        size_t blockEnd = (size - i > 16 ? i + 16 : size);
+        while (i < blockEnd) foldCharacter(text, size, i, out, folding, positions);
+      }
+
+      (void)avx2;
+      return out;
+    }
+
+  private:
+
+    /**
+    * Folding of a two-byte character
+    */
+    struct Folding {
+      uint16_t lower;  ///< The lowercase code point
+      uint16_t bare;   ///< The lowercase code point without diacritics
+      char     suffix; ///< A second ASCII letter without diacritics, as in "ae", or 0
+    };
+
+    /// Folded code points: U+00C0 to U+024F then U+0370 to U+045F
+    static const uint32_t LATIN_FIRST  = 0x00C0;
+    static const uint32_t LATIN_END    = 0x0250;
+    static const uint32_t GREEK_FIRST  = 0x0370;
+    static const uint32_t CYRILLIC_END = 0x0460;
+
+    /// Combining diacritical marks, removed along with diacritics
+    static const uint32_t COMBINING_FIRST = 0x0300;
+    static const uint32_t COMBINING_END   = 0x0370;
+
+    /**
+    * Fold the character at i, writing it at out
+    */
+    static void foldCharacter(char* text, size_t size, size_t& i, size_t& out, UnicodeFolding folding, uint32_t* positions) {
+      unsigned char lead = static_cast<unsigned char>(text[i]);
+
+      bool twoBytes = (lead & 0xE0) == 0xC0 && i + 1 < size && (static_cast<unsigned char>(text[i + 1]) & 0xC0) == 0x80;
+      uint32_t codePoint = twoBytes ? (static_cast<uint32_t>(lead & 0x1F) << 6) | (text[i + 1] & 0x3F) : 0;
+
+      const Folding* folded = nullptr;
+      if (codePoint >= LATIN_FIRST && codePoint < LATIN_END) folded = foldings() + (codePoint - LATIN_FIRST);
+      if (codePoint >= GREEK_FIRST && codePoint < CYRILLIC_END) folded = foldings() + (LATIN_END - LATIN_FIRST) + (codePoint - GREEK_FIRST);
+
+      if (folded == nullptr) {
+        if (folding == UNICODE_ACCENT_FOLDING && codePoint >= COMBINING_FIRST && codePoint < COMBINING_END) {
+          i += 2;
+          return;
+        }
+
+        // Kept as is, two bytes at once when valid
+        size_t count = twoBytes ? 2 : 1;
+        for (size_t k = 0; k < count; ++k) put(text, out, text[i + k], i, positions);
+        i += count;
+        return;
+      }
+
+      size_t first = i;
+      i += 2;
+
+      if (folding == UNICODE_ACCENT_FOLDING) {
+        encode(text, out, folded->bare, first, positions);
+        if (folded->suffix) put(text, out, folded->suffix, first, positions);
+      } else {
+        encode(text, out, folded->lower, first, positions);
+      }
+    }
+
+    /**
+    * Write a code point lower than U+0800 as one or two bytes
+    */
+    static void encode(char* text, size_t& out, uint32_t codePoint, size_t from, uint32_t* positions) {
+      if (codePoint < 0x80) return put(text, out, static_cast<char>(codePoint), from, positions);
+
+      put(text, out, static_cast<char>(0xC0 | (codePoint >> 6)), from, positions);
+      put(text, out, static_cast<char>(0x80 | (codePoint & 0x3F)), from, positions);
+    }
+
+    static void put(char* text, size_t& out, char ch, size_t from, uint32_t* positions) {
+      if (positions) positions[out] = static_cast<uint32_t>(from);
+      text[out++] = ch;
+    }
+
+#if defined(CONCEPT_UNICODEFOLDER_SSE2)
+
+    /**
+    * Skip blocks of 16 ASCII bytes, moving them back to out
+    */
+    static void skipAscii(char* text, size_t size, size_t& i, size_t& out, uint32_t* positions) {
+      for (; i + 16 <= size; i += 16, out += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        if (_mm_movemask_epi8(block) != 0) return;
+
+        if (out != i) _mm_storeu_si128(reinterpret_cast<__m128i*>(text + out), block);
+        if (positions) storePositions(positions + out, i, 16);
+      }
+    }
+
+    /**
+    * Write consecutive offsets from i, by 4
+    */
+    static void storePositions(uint32_t* positions, size_t i, size_t count) {
+      __m128i offsets = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), _mm_setr_epi32(0, 1, 2, 3));
+      for (size_t k = 0; k < count; k += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(positions + k), offsets);
+        offsets = _mm_add_epi32(offsets, _mm_set1_epi32(4));
+      }
+    }
+
+#endif
+
+#if defined(CONCEPT_CPU_X86)
+
+    /**
+    * Skip blocks of 32 ASCII bytes, moving them back to out
+    */
+    CONCEPT_TARGET("avx2")
+    static void skipAsciiAvx2(char* text, size_t size, size_t& i, size_t& out, uint32_t* positions) {
+      for (; i + 32 <= size; i += 32, out += 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        if (_mm256_movemask_epi8(block) != 0) return;
+
+        if (out != i) _mm256_storeu_si256(reinterpret_cast<__m256i*>(text + out), block);
+        if (positions) {
+          __m256i offsets = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+          for (size_t k = 0; k < 32; k += 8) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(positions + out + k), offsets);
+            offsets = _mm256_add_epi32(offsets, _mm256_set1_epi32(8));
+          }
+        }
+      }
+    }
+
+#endif
+
+    /**
+    * @return the folding of U+00C0 to U+024F, then of U+0370 to U+045F
+    */
+    static const Folding* foldings() {
+      static const Folding table[] = {
+        // U+00C0 to U+024F: Latin-1 Supplement, Latin Extended-A and Latin Extended-B
+        { 0x00E0, 0x0061, 0 }, { 0x00E1, 0x0061, 0 }, { 0x00E2, 0x0061, 0 }, { 0x00E3, 0x0061, 0 },
+        { 0x00E4, 0x0061, 0 }, { 0x00E5, 0x0061, 0 }, { 0x00E6, 0x0061, 'e' }, { 0x00E7, 0x0063, 0 },
+        { 0x00E8, 0x0065, 0 }, { 0x00E9, 0x0065, 0 }, { 0x00EA, 0x0065, 0 }, { 0x00EB, 0x0065, 0 },
+        { 0x00EC, 0x0069, 0 }, { 0x00ED, 0x0069, 0 }, { 0x00EE, 0x0069, 0 }, { 0x00EF, 0x0069, 0 },
+        { 0x00F0, 0x0064, 0 }, { 0x00F1, 0x006E, 0 }, { 0x00F2, 0x006F, 0 }, { 0x00F3, 0x006F, 0 },
+        { 0x00F4, 0x006F, 0 }, { 0x00F5, 0x006F, 0 }, { 0x00F6, 0x006F, 0 }, { 0x00D7, 0x00D7, 0 },
+        { 0x00F8, 0x006F, 0 }, { 0x00F9, 0x0075, 0 }, { 0x00FA, 0x0075, 0 }, { 0x00FB, 0x0075, 0 },
+        { 0x00FC, 0x0075, 0 }, { 0x00FD, 0x0079, 0 }, { 0x00FE, 0x0074, 'h' }, { 0x00DF, 0x0073, 's' },
+        { 0x00E0, 0x0061, 0 }, { 0x00E1, 0x0061, 0 }, { 0x00E2, 0x0061, 0 }, { 0x00E3, 0x0061, 0 },
+        { 0x00E4, 0x0061, 0 }, { 0x00E5, 0x0061, 0 }, { 0x00E6, 0x0061, 'e' }, { 0x00E7, 0x0063, 0 },
+        { 0x00E8, 0x0065, 0 }, { 0x00E9, 0x0065, 0 }, { 0x00EA, 0x0065, 0 }, { 0x00EB, 0x0065, 0 },
+        { 0x00EC, 0x0069, 0 }, { 0x00ED, 0x0069, 0 }, { 0x00EE, 0x0069, 0 }, { 0x00EF, 0x0069, 0 },
+        { 0x00F0, 0x0064, 0 }, { 0x00F1, 0x006E, 0 }, { 0x00F2, 0x006F, 0 }, { 0x00F3, 0x006F, 0 },
+        { 0x00F4, 0x006F, 0 }, { 0x00F5, 0x006F, 0 }, { 0x00F6, 0x006F, 0 }, { 0x00F7, 0x00F7, 0 },
+        { 0x00F8, 0x006F, 0 }, { 0x00F9, 0x0075, 0 }, { 0x00FA, 0x0075, 0 }, { 0x00FB, 0x0075, 0 },
+        { 0x00FC, 0x0075, 0 }, { 0x00FD, 0x0079, 0 }, { 0x00FE, 0x0074, 'h' }, { 0x00FF, 0x0079, 0 },
+        { 0x0101, 0x0061, 0 }, { 0x0101, 0x0061, 0 }, { 0x0103, 0x0061, 0 }, { 0x0103, 0x0061, 0 },
+        { 0x0105, 0x0061, 0 }, { 0x0105, 0x0061, 0 }, { 0x0107, 0x0063, 0 }, { 0x0107, 0x0063, 0 },
+        { 0x0109, 0x0063, 0 }, { 0x0109, 0x0063, 0 }, { 0x010B, 0x0063, 0 }, { 0x010B, 0x0063, 0 },
+        { 0x010D, 0x0063, 0 }, { 0x010D, 0x0063, 0 }, { 0x010F, 0x0064, 0 }, { 0x010F, 0x0064, 0 },
+        { 0x0111, 0x0064, 0 }, { 0x0111, 0x0064, 0 }, { 0x0113, 0x0065, 0 }, { 0x0113, 0x0065, 0 },
+        { 0x0115, 0x0065, 0 }, { 0x0115, 0x0065, 0 }, { 0x0117, 0x0065, 0 }, { 0x0117, 0x0065, 0 },
+        { 0x0119, 0x0065, 0 }, { 0x0119, 0x0065, 0 }, { 0x011B, 0x0065, 0 }, { 0x011B, 0x0065, 0 },
+        { 0x011D, 0x0067, 0 }, { 0x011D, 0x0067, 0 }, { 0x011F, 0x0067, 0 }, { 0x011F, 0x0067, 0 },
+        { 0x0121, 0x0067, 0 }, { 0x0121, 0x0067, 0 }, { 0x0123, 0x0067, 0 }, { 0x0123, 0x0067, 0 },
+        { 0x0125, 0x0068, 0 }, { 0x0125, 0x0068, 0 }, { 0x0127, 0x0068, 0 }, { 0x0127, 0x0068, 0 },
+        { 0x0129, 0x0069, 0 }, { 0x0129, 0x0069, 0 }, { 0x012B, 0x0069, 0 }, { 0x012B, 0x0069, 0 },
+        { 0x012D, 0x0069, 0 }, { 0x012D, 0x0069, 0 }, { 0x012F, 0x0069, 0 }, { 0x012F, 0x0069, 0 },
+        { 0x0069, 0x0069, 0 }, { 0x0131, 0x0069, 0 }, { 0x0133, 0x0069, 'j' }, { 0x0133, 0x0069, 'j' },
+        { 0x0135, 0x006A, 0 }, { 0x0135, 0x006A, 0 }, { 0x0137, 0x006B, 0 }, { 0x0137, 0x006B, 0 },
+        { 0x0138, 0x006B, 0 }, { 0x013A, 0x006C, 0 }, { 0x013A, 0x006C, 0 }, { 0x013C, 0x006C, 0 },
+        { 0x013C, 0x006C, 0 }, { 0x013E, 0x006C, 0 }, { 0x013E, 0x006C, 0 }, { 0x0140, 0x006C, 0 },
+        { 0x0140, 0x006C, 0 }, { 0x0142, 0x006C, 0 }, { 0x0142, 0x006C, 0 }, { 0x0144, 0x006E, 0 },
+        { 0x0144, 0x006E, 0 }, { 0x0146, 0x006E, 0 }, { 0x0146, 0x006E, 0 }, { 0x0148, 0x006E, 0 },
+        { 0x0148, 0x006E, 0 }, { 0x0149, 0x006E, 0 }, { 0x014B, 0x006E, 0 }, { 0x014B, 0x006E, 0 },
+        { 0x014D, 0x006F, 0 }, { 0x014D, 0x006F, 0 }, { 0x014F, 0x006F, 0 }, { 0x014F, 0x006F, 0 },
+        { 0x0151, 0x006F, 0 }, { 0x0151, 0x006F, 0 }, { 0x0153, 0x006F, 'e' }, { 0x0153, 0x006F, 'e' },
+        { 0x0155, 0x0072, 0 }, { 0x0155, 0x0072, 0 }, { 0x0157, 0x0072, 0 }, { 0x0157, 0x0072, 0 },
+        { 0x0159, 0x0072, 0 }, { 0x0159, 0x0072, 0 }, { 0x015B, 0x0073, 0 }, { 0x015B, 0x0073, 0 },
+        { 0x015D, 0x0073, 0 }, { 0x015D, 0x0073, 0 }, { 0x015F, 0x0073, 0 }, { 0x015F, 0x0073, 0 },
+        { 0x0161, 0x0073, 0 }, { 0x0161, 0x0073, 0 }, { 0x0163, 0x0074, 0 }, { 0x0163, 0x0074, 0 },
+        { 0x0165, 0x0074, 0 }, { 0x0165, 0x0074, 0 }, { 0x0167, 0x0074, 0 }, { 0x0167, 0x0074, 0 },
+        { 0x0169, 0x0075, 0 }, { 0x0169, 0x0075, 0 }, { 0x016B, 0x0075, 0 }, { 0x016B, 0x0075, 0 },
+        { 0x016D, 0x0075, 0 }, { 0x016D, 0x0075, 0 }, { 0x016F, 0x0075, 0 }, { 0x016F, 0x0075, 0 },
+        { 0x0171, 0x0075, 0 }, { 0x0171, 0x0075, 0 }, { 0x0173, 0x0075, 0 }, { 0x0173, 0x0075, 0 },
+        { 0x0175, 0x0077, 0 }, { 0x0175, 0x0077, 0 }, { 0x0177, 0x0079, 0 }, { 0x0177, 0x0079, 0 },
+        { 0x00FF, 0x0079, 0 }, { 0x017A, 0x007A, 0 }, { 0x017A, 0x007A, 0 }, { 0x017C, 0x007A, 0 },
+        { 0x017C, 0x007A, 0 }, { 0x017E, 0x007A, 0 }, { 0x017E, 0x007A, 0 }, { 0x017F, 0x0073, 0 },
+        { 0x0180, 0x0062, 0 }, { 0x0253, 0x0253, 0 }, { 0x0183, 0x0062, 0 }, { 0x0183, 0x0062, 0 },
+        { 0x0185, 0x0185, 0 }, { 0x0185, 0x0185, 0 }, { 0x0254, 0x0254, 0 }, { 0x0188, 0x0063, 0 },
+        { 0x0188, 0x0063, 0 }, { 0x0256, 0x0256, 0 }, { 0x0257, 0x0064, 0 }, { 0x018C, 0x0064, 0 },
+        { 0x018C, 0x0064, 0 }, { 0x018D, 0x018D, 0 }, { 0x01DD, 0x01DD, 0 }, { 0x0259, 0x0259, 0 },
+        { 0x025B, 0x025B, 0 }, { 0x0192, 0x0066, 0 }, { 0x0192, 0x0066, 0 }, { 0x0260, 0x0067, 0 },
+        { 0x0263, 0x0263, 0 }, { 0x0195, 0x0195, 0 }, { 0x0269, 0x0269, 0 }, { 0x0268, 0x0268, 0 },
+        { 0x0199, 0x006B, 0 }, { 0x0199, 0x006B, 0 }, { 0x019A, 0x006C, 0 }, { 0x019B, 0x019B, 0 },
+        { 0x026F, 0x026F, 0 }, { 0x0272, 0x0272, 0 }, { 0x019E, 0x006E, 0 }, { 0x0275, 0x006F, 0 },
+        { 0x01A1, 0x006F, 0 }, { 0x01A1, 0x006F, 0 }, { 0x01A3, 0x01A3, 0 }, { 0x01A3, 0x01A3, 0 },
+        { 0x01A5, 0x0070, 0 }, { 0x01A5, 0x0070, 0 }, { 0x0280, 0x0280, 0 }, { 0x01A8, 0x01A8, 0 },
+        { 0x01A8, 0x01A8, 0 }, { 0x0283, 0x0283, 0 }, { 0x01AA, 0x01AA, 0 }, { 0x01AB, 0x0074, 0 },
+        { 0x01AD, 0x0074, 0 }, { 0x01AD, 0x0074, 0 }, { 0x0288, 0x0074, 0 }, { 0x01B0, 0x0075, 0 },
+        { 0x01B0, 0x0075, 0 }, { 0x028A, 0x028A, 0 }, { 0x028B, 0x028B, 0 }, { 0x01B4, 0x0079, 0 },
+        { 0x01B4, 0x0079, 0 }, { 0x01B6, 0x007A, 0 }, { 0x01B6, 0x007A, 0 }, { 0x0292, 0x0292, 0 },
+        { 0x01B9, 0x01B9, 0 }, { 0x01B9, 0x01B9, 0 }, { 0x01BA, 0x01BA, 0 }, { 0x01BB, 0x01BB, 0 },
+        { 0x01BD, 0x01BD, 0 }, { 0x01BD, 0x01BD, 0 }, { 0x01BE, 0x01BE, 0 }, { 0x01BF, 0x01BF, 0 },
+        { 0x01C0, 0x01C0, 0 }, { 0x01C1, 0x01C1, 0 }, { 0x01C2, 0x01C2, 0 }, { 0x01C3, 0x01C3, 0 },
+        { 0x01C6, 0x0064, 'z' }, { 0x01C6, 0x0064, 'z' }, { 0x01C6, 0x0064, 'z' }, { 0x01C9, 0x006C, 'j' },
+        { 0x01C9, 0x006C, 'j' }, { 0x01C9, 0x006C, 'j' }, { 0x01CC, 0x006E, 'j' }, { 0x01CC, 0x006E, 'j' },
+        { 0x01CC, 0x006E, 'j' }, { 0x01CE, 0x0061, 0 }, { 0x01CE, 0x0061, 0 }, { 0x01D0, 0x0069, 0 },
+        { 0x01D0, 0x0069, 0 }, { 0x01D2, 0x006F, 0 }, { 0x01D2, 0x006F, 0 }, { 0x01D4, 0x0075, 0 },
+        { 0x01D4, 0x0075, 0 }, { 0x01D6, 0x0075, 0 }, { 0x01D6, 0x0075, 0 }, { 0x01D8, 0x0075, 0 },
+        { 0x01D8, 0x0075, 0 }, { 0x01DA, 0x0075, 0 }, { 0x01DA, 0x0075, 0 }, { 0x01DC, 0x0075, 0 },
+        { 0x01DC, 0x0075, 0 }, { 0x01DD, 0x01DD, 0 }, { 0x01DF, 0x0061, 0 }, { 0x01DF, 0x0061, 0 },
+        { 0x01E1, 0x0061, 0 }, { 0x01E1, 0x0061, 0 }, { 0x01E3, 0x00E6, 0 }, { 0x01E3, 0x00E6, 0 },
+        { 0x01E5, 0x0067, 0 }, { 0x01E5, 0x0067, 0 }, { 0x01E7, 0x0067, 0 }, { 0x01E7, 0x0067, 0 },
+        { 0x01E9, 0x006B, 0 }, { 0x01E9, 0x006B, 0 }, { 0x01EB, 0x006F, 0 }, { 0x01EB, 0x006F, 0 },
+        { 0x01ED, 0x006F, 0 }, { 0x01ED, 0x006F, 0 }, { 0x01EF, 0x0292, 0 }, { 0x01EF, 0x0292, 0 },
+        { 0x01F0, 0x006A, 0 }, { 0x01F3, 0x0064, 'z' }, { 0x01F3, 0x0064, 'z' }, { 0x01F3, 0x0064, 'z' },
+        { 0x01F5, 0x0067, 0 }, { 0x01F5, 0x0067, 0 }, { 0x0195, 0x0195, 0 }, { 0x01BF, 0x01BF, 0 },
+        { 0x01F9, 0x006E, 0 }, { 0x01F9, 0x006E, 0 }, { 0x01FB, 0x0061, 0 }, { 0x01FB, 0x0061, 0 },
+        { 0x01FD, 0x00E6, 0 }, { 0x01FD, 0x00E6, 0 }, { 0x01FF, 0x00F8, 0 }, { 0x01FF, 0x00F8, 0 },
+        { 0x0201, 0x0061, 0 }, { 0x0201, 0x0061, 0 }, { 0x0203, 0x0061, 0 }, { 0x0203, 0x0061, 0 },
+        { 0x0205, 0x0065, 0 }, { 0x0205, 0x0065, 0 }, { 0x0207, 0x0065, 0 }, { 0x0207, 0x0065, 0 },
+        { 0x0209, 0x0069, 0 }, { 0x0209, 0x0069, 0 }, { 0x020B, 0x0069, 0 }, { 0x020B, 0x0069, 0 },
+        { 0x020D, 0x006F, 0 }, { 0x020D, 0x006F, 0 }, { 0x020F, 0x006F, 0 }, { 0x020F, 0x006F, 0 },
+        { 0x0211, 0x0072, 0 }, { 0x0211, 0x0072, 0 }, { 0x0213, 0x0072, 0 }, { 0x0213, 0x0072, 0 },
+        { 0x0215, 0x0075, 0 }, { 0x0215, 0x0075, 0 }, { 0x0217, 0x0075, 0 }, { 0x0217, 0x0075, 0 },
+        { 0x0219, 0x0073, 0 }, { 0x0219, 0x0073, 0 }, { 0x021B, 0x0074, 0 }, { 0x021B, 0x0074, 0 },
+        { 0x021D, 0x021D, 0 }, { 0x021D, 0x021D, 0 }, { 0x021F, 0x0068, 0 }, { 0x021F, 0x0068, 0 },
+        { 0x019E, 0x006E, 0 }, { 0x0221, 0x0064, 0 }, { 0x0223, 0x0223, 0 }, { 0x0223, 0x0223, 0 },
+        { 0x0225, 0x007A, 0 }, { 0x0225, 0x007A, 0 }, { 0x0227, 0x0061, 0 }, { 0x0227, 0x0061, 0 },
+        { 0x0229, 0x0065, 0 }, { 0x0229, 0x0065, 0 }, { 0x022B, 0x006F, 0 }, { 0x022B, 0x006F, 0 },
+        { 0x022D, 0x006F, 0 }, { 0x022D, 0x006F, 0 }, { 0x022F, 0x006F, 0 }, { 0x022F, 0x006F, 0 },
+        { 0x0231, 0x006F, 0 }, { 0x0231, 0x006F, 0 }, { 0x0233, 0x0079, 0 }, { 0x0233, 0x0079, 0 },
+        { 0x0234, 0x006C, 0 }, { 0x0235, 0x006E, 0 }, { 0x0236, 0x0074, 0 }, { 0x0237, 0x006A, 0 },
+        { 0x0238, 0x0064, 'b' }, { 0x0239, 0x0071, 'p' }, { 0x023A, 0x023A, 0 }, { 0x023C, 0x0063, 0 },
+        { 0x023C, 0x0063, 0 }, { 0x019A, 0x006C, 0 }, { 0x023E, 0x023E, 0 }, { 0x023F, 0x0073, 0 },
+        { 0x0240, 0x007A, 0 }, { 0x0242, 0x0242, 0 }, { 0x0242, 0x0242, 0 }, { 0x0180, 0x0062, 0 },
+        { 0x0289, 0x0289, 0 }, { 0x028C, 0x028C, 0 }, { 0x0247, 0x0065, 0 }, { 0x0247, 0x0065, 0 },
+        { 0x0249, 0x006A, 0 }, { 0x0249, 0x006A, 0 }, { 0x024B, 0x0071, 0 }, { 0x024B, 0x0071, 0 },
+        { 0x024D, 0x0072, 0 }, { 0x024D, 0x0072, 0 }, { 0x024F, 0x0079, 0 }, { 0x024F, 0x0079, 0 },
+
+        // U+0370 to U+045F: Greek and Coptic, then the basic Cyrillic letters
+        { 0x0371, 0x0371, 0 }, { 0x0371, 0x0371, 0 }, { 0x0373, 0x0373, 0 }, { 0x0373, 0x0373, 0 },
+        { 0x0374, 0x02B9, 0 }, { 0x0375, 0x0375, 0 }, { 0x0377, 0x0377, 0 }, { 0x0377, 0x0377, 0 },
+        { 0x0378, 0x0378, 0 }, { 0x0379, 0x0379, 0 }, { 0x037A, 0x0020, 0 }, { 0x037B, 0x037B, 0 },
+        { 0x037C, 0x037C, 0 }, { 0x037D, 0x037D, 0 }, { 0x037E, 0x003B, 0 }, { 0x03F3, 0x03F3, 0 },
+        { 0x0380, 0x0380, 0 }, { 0x0381, 0x0381, 0 }, { 0x0382, 0x0382, 0 }, { 0x0383, 0x0383, 0 },
+        { 0x0384, 0x0020, 0 }, { 0x0385, 0x0020, 0 }, { 0x03AC, 0x03B1, 0 }, { 0x0387, 0x00B7, 0 },
+        { 0x03AD, 0x03B5, 0 }, { 0x03AE, 0x03B7, 0 }, { 0x03AF, 0x03B9, 0 }, { 0x038B, 0x038B, 0 },
+        { 0x03CC, 0x03BF, 0 }, { 0x038D, 0x038D, 0 }, { 0x03CD, 0x03C5, 0 }, { 0x03CE, 0x03C9, 0 },
+        { 0x0390, 0x03B9, 0 }, { 0x03B1, 0x03B1, 0 }, { 0x03B2, 0x03B2, 0 }, { 0x03B3, 0x03B3, 0 },
+        { 0x03B4, 0x03B4, 0 }, { 0x03B5, 0x03B5, 0 }, { 0x03B6, 0x03B6, 0 }, { 0x03B7, 0x03B7, 0 },
+        { 0x03B8, 0x03B8, 0 }, { 0x03B9, 0x03B9, 0 }, { 0x03BA, 0x03BA, 0 }, { 0x03BB, 0x03BB, 0 },
+        { 0x03BC, 0x03BC, 0 }, { 0x03BD, 0x03BD, 0 }, { 0x03BE, 0x03BE, 0 }, { 0x03BF, 0x03BF, 0 },
+        { 0x03C0, 0x03C0, 0 }, { 0x03C1, 0x03C1, 0 }, { 0x03A2, 0x03A2, 0 }, { 0x03C3, 0x03C3, 0 },
+        { 0x03C4, 0x03C4, 0 }, { 0x03C5, 0x03C5, 0 }, { 0x03C6, 0x03C6, 0 }, { 0x03C7, 0x03C7, 0 },
+        { 0x03C8, 0x03C8, 0 }, { 0x03C9, 0x03C9, 0 }, { 0x03CA, 0x03B9, 0 }, { 0x03CB, 0x03C5, 0 },
+        { 0x03AC, 0x03B1, 0 }, { 0x03AD, 0x03B5, 0 }, { 0x03AE, 0x03B7, 0 }, { 0x03AF, 0x03B9, 0 },
+        { 0x03B0, 0x03C5, 0 }, { 0x03B1, 0x03B1, 0 }, { 0x03B2, 0x03B2, 0 }, { 0x03B3, 0x03B3, 0 },
+        { 0x03B4, 0x03B4, 0 }, { 0x03B5, 0x03B5, 0 }, { 0x03B6, 0x03B6, 0 }, { 0x03B7, 0x03B7, 0 },
+        { 0x03B8, 0x03B8, 0 }, { 0x03B9, 0x03B9, 0 }, { 0x03BA, 0x03BA, 0 }, { 0x03BB, 0x03BB, 0 },
+        { 0x03BC, 0x03BC, 0 }, { 0x03BD, 0x03BD, 0 }, { 0x03BE, 0x03BE, 0 }, { 0x03BF, 0x03BF, 0 },
+        { 0x03C0, 0x03C0, 0 }, { 0x03C1, 0x03C1, 0 }, { 0x03C3, 0x03C3, 0 }, { 0x03C3, 0x03C3, 0 },
+        { 0x03C4, 0x03C4, 0 }, { 0x03C5, 0x03C5, 0 }, { 0x03C6, 0x03C6, 0 }, { 0x03C7, 0x03C7, 0 },
+        { 0x03C8, 0x03C8, 0 }, { 0x03C9, 0x03C9, 0 }, { 0x03CA, 0x03B9, 0 }, { 0x03CB, 0x03C5, 0 },
+        { 0x03CC, 0x03BF, 0 }, { 0x03CD, 0x03C5, 0 }, { 0x03CE, 0x03C9, 0 }, { 0x03D7, 0x03D7, 0 },
+        { 0x03D0, 0x03B2, 0 }, { 0x03D1, 0x03B8, 0 }, { 0x03D2, 0x03A5, 0 }, { 0x03D3, 0x03A5, 0 },
+        { 0x03D4, 0x03A5, 0 }, { 0x03D5, 0x03C6, 0 }, { 0x03D6, 0x03C0, 0 }, { 0x03D7, 0x03D7, 0 },
+        { 0x03D9, 0x03D9, 0 }, { 0x03D9, 0x03D9, 0 }, { 0x03DB, 0x03DB, 0 }, { 0x03DB, 0x03DB, 0 },
+        { 0x03DD, 0x03DD, 0 }, { 0x03DD, 0x03DD, 0 }, { 0x03DF, 0x03DF, 0 }, { 0x03DF, 0x03DF, 0 },
+        { 0x03E1, 0x03E1, 0 }, { 0x03E1, 0x03E1, 0 }, { 0x03E3, 0x03E3, 0 }, { 0x03E3, 0x03E3, 0 },
+        { 0x03E5, 0x03E5, 0 }, { 0x03E5, 0x03E5, 0 }, { 0x03E7, 0x03E7, 0 }, { 0x03E7, 0x03E7, 0 },
+        { 0x03E9, 0x03E9, 0 }, { 0x03E9, 0x03E9, 0 }, { 0x03EB, 0x03EB, 0 }, { 0x03EB, 0x03EB, 0 },
+        { 0x03ED, 0x03ED, 0 }, { 0x03ED, 0x03ED, 0 }, { 0x03EF, 0x03EF, 0 }, { 0x03EF, 0x03EF, 0 },
+        { 0x03F0, 0x03BA, 0 }, { 0x03F1, 0x03C1, 0 }, { 0x03F2, 0x03C2, 0 }, { 0x03F3, 0x03F3, 0 },
+        { 0x03B8, 0x03B8, 0 }, { 0x03F5, 0x03B5, 0 }, { 0x03F6, 0x03F6, 0 }, { 0x03F8, 0x03F8, 0 },
+        { 0x03F8, 0x03F8, 0 }, { 0x03F2, 0x03C2, 0 }, { 0x03FB, 0x03FB, 0 }, { 0x03FB, 0x03FB, 0 },
+        { 0x03FC, 0x03FC, 0 }, { 0x037B, 0x037B, 0 }, { 0x037C, 0x037C, 0 }, { 0x037D, 0x037D, 0 },
+        { 0x0450, 0x0435, 0 }, { 0x0451, 0x0435, 0 }, { 0x0452, 0x0452, 0 }, { 0x0453, 0x0433, 0 },
+        { 0x0454, 0x0454, 0 }, { 0x0455, 0x0455, 0 }, { 0x0456, 0x0456, 0 }, { 0x0457, 0x0456, 0 },
+        { 0x0458, 0x0458, 0 }, { 0x0459, 0x0459, 0 }, { 0x045A, 0x045A, 0 }, { 0x045B, 0x045B, 0 },
+        { 0x045C, 0x043A, 0 }, { 0x045D, 0x0438, 0 }, { 0x045E, 0x0443, 0 }, { 0x045F, 0x045F, 0 },
+        { 0x0430, 0x0430, 0 }, { 0x0431, 0x0431, 0 }, { 0x0432, 0x0432, 0 }, { 0x0433, 0x0433, 0 },
+        { 0x0434, 0x0434, 0 }, { 0x0435, 0x0435, 0 }, { 0x0436, 0x0436, 0 }, { 0x0437, 0x0437, 0 },
+        { 0x0438, 0x0438, 0 }, { 0x0439, 0x0438, 0 }, { 0x043A, 0x043A, 0 }, { 0x043B, 0x043B, 0 },
+        { 0x043C, 0x043C, 0 }, { 0x043D, 0x043D, 0 }, { 0x043E, 0x043E, 0 }, { 0x043F, 0x043F, 0 },
+        { 0x0440, 0x0440, 0 }, { 0x0441, 0x0441, 0 }, { 0x0442, 0x0442, 0 }, { 0x0443, 0x0443, 0 },
+        { 0x0444, 0x0444, 0 }, { 0x0445, 0x0445, 0 }, { 0x0446, 0x0446, 0 }, { 0x0447, 0x0447, 0 },
+        { 0x0448, 0x0448, 0 }, { 0x0449, 0x0449, 0 }, { 0x044A, 0x044A, 0 }, { 0x044B, 0x044B, 0 },
+        { 0x044C, 0x044C, 0 }, { 0x044D, 0x044D, 0 }, { 0x044E, 0x044E, 0 }, { 0x044F, 0x044F, 0 },
+        { 0x0430, 0x0430, 0 }, { 0x0431, 0x0431, 0 }, { 0x0432, 0x0432, 0 }, { 0x0433, 0x0433, 0 },
+        { 0x0434, 0x0434, 0 }, { 0x0435, 0x0435, 0 }, { 0x0436, 0x0436, 0 }, { 0x0437, 0x0437, 0 },
+        { 0x0438, 0x0438, 0 }, { 0x0439, 0x0438, 0 }, { 0x043A, 0x043A, 0 }, { 0x043B, 0x043B, 0 },
+        { 0x043C, 0x043C, 0 }, { 0x043D, 0x043D, 0 }, { 0x043E, 0x043E, 0 }, { 0x043F, 0x043F, 0 },
+        { 0x0440, 0x0440, 0 }, { 0x0441, 0x0441, 0 }, { 0x0442, 0x0442, 0 }, { 0x0443, 0x0443, 0 },
+        { 0x0444, 0x0444, 0 }, { 0x0445, 0x0445, 0 }, { 0x0446, 0x0446, 0 }, { 0x0447, 0x0447, 0 },
+        { 0x0448, 0x0448, 0 }, { 0x0449, 0x0449, 0 }, { 0x044A, 0x044A, 0 }, { 0x044B, 0x044B, 0 },
+        { 0x044C, 0x044C, 0 }, { 0x044D, 0x044D, 0 }, { 0x044E, 0x044E, 0 }, { 0x044F, 0x044F, 0 },
+        { 0x0450, 0x0435, 0 }, { 0x0451, 0x0435, 0 }, { 0x0452, 0x0452, 0 }, { 0x0453, 0x0433, 0 },
+        { 0x0454, 0x0454, 0 }, { 0x0455, 0x0455, 0 }, { 0x0456, 0x0456, 0 }, { 0x0457, 0x0456, 0 },
+        { 0x0458, 0x0458, 0 }, { 0x0459, 0x0459, 0 }, { 0x045A, 0x045A, 0 }, { 0x045B, 0x045B, 0 },
+        { 0x045C, 0x043A, 0 }, { 0x045D, 0x0438, 0 }, { 0x045E, 0x0443, 0 }, { 0x045F, 0x045F, 0 },
+      };
+
+      return table;
+    }
+  };
+
+} // end namespace Concept
+
+#endif
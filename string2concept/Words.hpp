@@ -32,130 +32,396 @@
 #ifndef CONCEPT_WORDS_HPP
 #define CONCEPT_WORDS_HPP
 
-#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
 
 #include "core/String.hpp"
 #include "core/Vector.hpp"
+#include "core/View.hpp"
+#include "TextPolicy.hpp"
 
 namespace Concept {
 
-  class Words {
+  /**
+  * Words of a text, overlaying or copying its buffer.
+  * Separators are defined by the Policy template parameter, a TextPolicy
+  *
+  * Words are a stream of parallel columns: 32-bit offsets in the buffer, 16-bit lengths,
+  * and optionally the hash of every word. Copied words are packed into one buffer, separated by single spaces,
+  * so that splitting a text costs a few allocations, whatever its number of words.
+  */
+  template <typename Policy = DefaultTextPolicy>
+  class BasicWords {
 
   public:
-    using WordVector = Vector<Vector<char> >;
+
+    /// Word offsets are 32-bit: texts are limited to 4 GiB
+    static const size_t MAX_TEXT_SIZE = std::numeric_limits<uint32_t>::max();
+
+    /**
+    * Random-access iterator over the words, as character views.
+    * The view is kept inside the iterator: references to it last as long as the iterator
+    */
+    class const_iterator {
+
+    public:
+      using iterator_category = std::random_access_iterator_tag;
+      using value_type        = View<char>;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const View<char>*;
+      using reference         = const View<char>&;
+
+      const_iterator(const BasicWords* words, size_t index) : _words(words), _index(index) {
+        load();
+      }
+
+      /**
+      * @return the index of the word
+      */
+      size_t index() const { return _index; }
+
+      reference operator*() const { return _word; }
+      pointer operator->() const { return &_word; }
+
+      const_iterator& operator++() { ++_index; load(); return *this; }
+      const_iterator& operator--() { --_index; load(); return *this; }
+      const_iterator& operator+=(difference_type n) { _index += n; load(); return *this; }
+      const_iterator& operator-=(difference_type n) { _index -= n; load(); return *this; }
+
+      const_iterator operator+(difference_type n) const { return const_iterator(_words, _index + n); }
+      const_iterator operator-(difference_type n) const { return const_iterator(_words, _index - n); }
+      difference_type operator-(const const_iterator& other) const {
+        return static_cast<difference_type>(_index) - static_cast<difference_type>(other._index);
+      }
+
+      bool operator==(const const_iterator& other) const { return _index == other._index; }
+      bool operator!=(const const_iterator& other) const { return _index != other._index; }
+      bool operator<(const const_iterator& other) const { return _index < other._index; }
+      bool operator>(const const_iterator& other) const { return _index > other._index; }
+      bool operator<=(const const_iterator& other) const { return _index <= other._index; }
+      bool operator>=(const const_iterator& other) const { return _index >= other._index; }
+
+    private:
+
+      /**
+      * View the current word, if any
+      */
+      void load() {
+        _word = (_index < _words->length() ? _words->word(_index) : View<char>());
+      }
+
+      const BasicWords* _words;
+      size_t            _index;
+      View<char>        _word;
+    };
 
     /**
     * Constructor
     * Extract words from text
     * @param text the text to pick words from
     * @param copy if true, the words are copied internally. Otherwise overlay the text buffer.
+    * @throw std::length_error if the text exceeds MAX_TEXT_SIZE
     */
     template <size_t N>
-    Words(const Vector<char, N>& text, bool copy = true) {
+    BasicWords(const Vector<char, N>& text, bool copy = true) {
+      if (text.size() > MAX_TEXT_SIZE) throw std::length_error("Text exceeds 32-bit word offsets");
 
-      _bufferOwned = copy;
+      // Count the words first, so that every column is allocated once
+      size_t charCount = 0;
+      size_t wordCount = countWords(text, charCount);
 
-      size_t wordLen = 0;
+      reserve(wordCount);
 
-      // Search for the beginning of the first word
-      auto wordStart = text.begin();
-      for (; wordStart != text.end() && isSeparator(*wordStart); ++wordStart);
+      if (!copy) {
+        _text = text.data();
+        forEachWord(text, [this](size_t offset, size_t wordLen) { add(offset, wordLen); });
+        return;
+      }
 
-      // Find words
-      for (auto it = wordStart; it != text.end(); ++it) {
+      // Pack the words, separated by single spaces
+      _buffer.reserve(charCount + (wordCount ? wordCount - 1 : 0));
+      forEachWord(text, [&](size_t offset, size_t wordLen) {
+        if (_buffer.size()) _buffer.push_back(' ');
+        add(_buffer.size(), wordLen);
+        _buffer += Vector<char>(text.data() + offset, wordLen, false);
+      });
 
-        // A separator marks the end of a word
-        if (isSeparator(*it)) { 
-          if (wordLen > 0) {
-            _words.push_back(Vector<char>(wordStart, wordLen, copy));
-            wordLen = 0;
-          }
-          continue;
-        }
+      _text = _buffer.data();
+    }
+
+    /**
+    * Constructor
+    * Overlay words already delimited in the text buffer
+    * @param text the text holding the words
+    * @param boundaries the offset of the first character then the past-the-end offset of every word
+    */
+    template <size_t N>
+    BasicWords(const Vector<char, N>& text, const Vector<uint32_t>& boundaries) : _text(text.data()) {
+      reserve(boundaries.size() / 2);
 
-        // A first regular character means new word
-        if (wordLen == 0) wordStart = it;
+      for (size_t i = 0; i + 1 < boundaries.size(); i += 2) add(boundaries[i], boundaries[i + 1] - boundaries[i]);
+    }
 
-        ++wordLen;
+    /**
+    * Constructor
+    * Overlay words already delimited in the text buffer, and fill the hash column in the same pass
+    * @param text the text holding the words
+    * @param boundaries the offset of the first character then the past-the-end offset of every word
+    * @param wordHash a function hashing the characters of a word, called as wordHash(data, length)
+    */
+    template <size_t N, typename WordHash>
+    BasicWords(const Vector<char, N>& text, const Vector<uint32_t>& boundaries, WordHash wordHash) :
+      _text(text.data()) {
+      reserve(boundaries.size() / 2);
+      _hashes.reserve(boundaries.size() / 2);
+
+      for (size_t i = 0; i + 1 < boundaries.size(); i += 2) {
+        size_t wordLen = boundaries[i + 1] - boundaries[i];
+        add(boundaries[i], wordLen);
+        _hashes.push_back(wordHash(_text + boundaries[i], wordLen));
       }
+    }
 
-      if (wordLen > 0) _words.push_back(Vector<char>(wordStart, wordLen, copy));
+    /**
+    * Copy constructor: copied words are packed again, overlays stay on the same text
+    */
+    BasicWords(const BasicWords& other) :
+      _text(other._text), _buffer(other._buffer), _offsets(other._offsets), _lengths(other._lengths),
+      _longLengths(other._longLengths), _hashes(other._hashes) {
+      if (other.copied()) _text = _buffer.data();
+    }
+
+    /**
+    * Move constructor: the packed words move along with their buffer
+    */
+    BasicWords(BasicWords&& other) :
+      _text(other._text), _buffer(std::move(other._buffer)), _offsets(std::move(other._offsets)),
+      _lengths(std::move(other._lengths)), _longLengths(std::move(other._longLengths)),
+      _hashes(std::move(other._hashes)) {
+      if (_buffer.size()) _text = _buffer.data();
     }
 
     /**
     * @return an iterator pointing to first word
     */
-    WordVector::const_iterator begin() const {
-      return _words.begin();
+    const_iterator begin() const {
+      return const_iterator(this, 0);
     }
 
     /**
     * @return an iterator pointing to the pass-the-end word
     */
-    WordVector::const_iterator end() const {
-      return _words.end();
+    const_iterator end() const {
+      return const_iterator(this, length());
+    }
+
+    /**
+    * @return the offset of a word in data()
+    */
+    size_t offset(size_t index) const {
+      return _offsets[index];
+    }
+
+    /**
+    * @return the number of characters of a word
+    */
+    size_t wordLength(size_t index) const {
+      uint16_t len = _lengths[index];
+      if (len != LONG_WORD) return len;
+
+      // Long words are rare, and listed by increasing index
+      auto it = std::lower_bound(_longLengths.begin(), _longLengths.end(), index,
+                                 [](const LongWord& word, size_t i) { return word.index < i; });
+      return it->length;
+    }
+
+    /**
+    * @return a view of a word
+    */
+    View<char> word(size_t index) const {
+      return View<char>(_text + _offsets[index], wordLength(index));
+    }
+
+    /**
+    * @return the hash of a word, if the words were hashed on construction
+    */
+    size_t hash(size_t index) const {
+      return _hashes[index];
+    }
+
+    /**
+    * @return true if the hash column is filled
+    */
+    bool hashed() const {
+      return _hashes.size() == length() && length() > 0;
+    }
+
+    /**
+    * @return the buffer the word offsets refer to
+    */
+    const char* data() const {
+      return _text;
     }
 
     /**
     * Get the sequence of 'wordCount' words starting at 'first'
+    * Copied words are returned as a copy, joined by single spaces. Otherwise an overlay of the text is returned
     * @return an empty Vector if the words cannot be found
     */
-    Vector<char> get(WordVector::const_iterator first, size_t wordCount) {
+    Vector<char> get(size_t first, size_t wordCount) const {
 
       // This number of words cannot be found, return
-      if (first + wordCount > end()) return Vector<char>();
+      if (wordCount == 0 || first + wordCount > length()) return Vector<char>();
 
-      // All words share the same buffer,
-       // just return a new not owned overlay vector spanning the requested range
-      if (!_bufferOwned) {
-        return Vector<char>(first->begin(), (first + wordCount - 1)->end() - first->begin(), false);
-       }
+      return Vector<char>(_text + _offsets[first], span(first, wordCount), copied());
+    }
 
-      // Get the total buffer size
-      size_t bufferLen = 0;
-      auto it = first;
+    /**
+    * Get the sequence of 'wordCount' words starting at 'first'
+    */
+    Vector<char> get(const_iterator first, size_t wordCount) const {
+      return get(first.index(), wordCount);
+    }
 
-      for (size_t i = 0; i < wordCount; ++i, ++it) {
-        bufferLen += it->size();
-      }
+    /**
+    * View the sequence of 'wordCount' words starting at 'first', without any copy.
+    * Copied words are viewed joined by single spaces
+    * @return an empty View if the words cannot be found
+    */
+    View<char> view(size_t first, size_t wordCount) const {
 
-      // Add the number of spaces between the words
-      bufferLen += wordCount - 1;
+      // This number of words cannot be found, return
+      if (wordCount == 0 || first + wordCount > length()) return View<char>();
 
-      // Reserve space
-      Vector<char> result;
-      result.reserve(bufferLen);
+      return View<char>(_text + _offsets[first], span(first, wordCount));
+    }
 
-      // Concatenate words
-      result += (*first);
-      it = first + 1;
-      for (size_t i = 1; i < wordCount; ++i, ++it) {
-       result += ' ';
-       result += (*it);
-      }
-      return result;
+    /**
+    * View the sequence of 'wordCount' words starting at 'first', without any copy
+    */
+    View<char> view(const_iterator first, size_t wordCount) const {
+      return view(first.index(), wordCount);
     }
 
     /**
     * @return the number of words
     */
     size_t length() const {
-      return _words.size();
+      return _offsets.size();
     }
 
     /**
     * @return true if ch is a separator
     */
     static bool isSeparator(char ch) {
-      return ch == ' ' || ch == 0;
+      return Policy::isSeparator(ch);
     }
 
   private:
 
-    WordVector _words;
-    bool       _bufferOwned;
+    /// Length of the words longer than the 16-bit column can hold
+    static const uint16_t LONG_WORD = UINT16_MAX;
+
+    /**
+    * Length of a long word
+    */
+    struct LongWord {
+      uint32_t index;
+      uint32_t length;
+    };
+
+    /**
+    * Visit the words of a text
+    * @param visit a function taking the offset and the length of every word
+    */
+    template <size_t N, typename Visitor>
+    static void forEachWord(const Vector<char, N>& text, Visitor visit) {
+      const char* chars = text.data();
+      size_t size = text.size();
+
+      for (size_t i = 0; i < size; ) {
+        if (isSeparator(chars[i])) { ++i; continue; }
+
+        size_t wordStart = i;
+        while (i < size && !isSeparator(chars[i])) ++i;
+
+        visit(wordStart, i - wordStart);
+      }
+    }
+
+    /**
+    * Count the words of a text without branching on characters, cheaper than splitting them
+    * @param charCount set to the number of characters that are not separators
+    */
+    template <size_t N>
+    static size_t countWords(const Vector<char, N>& text, size_t& charCount) {
+      const char* chars = text.data();
+      size_t wordCount = 0;
+      size_t separatorCount = 0;
+      bool previousSeparator = true;
+
+      for (size_t i = 0; i < text.size(); ++i) {
+        bool separator = isSeparator(chars[i]);
+        wordCount += previousSeparator & !separator;
+        separatorCount += separator;
+        previousSeparator = separator;
+      }
+
+      charCount = text.size() - separatorCount;
+      return wordCount;
+    }
+
+    /**
+    * Size the columns for a number of words
+    */
+    void reserve(size_t wordCount) {
+      _offsets.reserve(wordCount);
+      _lengths.reserve(wordCount);
+    }
+
+    /**
+    * Append a word to the columns
+    */
+    void add(size_t offset, size_t wordLen) {
+      if (wordLen >= LONG_WORD) {
+        LongWord longWord = { static_cast<uint32_t>(_offsets.size()), static_cast<uint32_t>(wordLen) };
+        _longLengths.push_back(longWord);
+      }
+
+      _offsets.push_back(static_cast<uint32_t>(offset));
+      _lengths.push_back(static_cast<uint16_t>(wordLen < LONG_WORD ? wordLen : LONG_WORD));
+    }
+
+    /**
+    * @return the number of characters from the first word to the end of the last one
+    */
+    size_t span(size_t first, size_t wordCount) const {
+      size_t last = first + wordCount - 1;
+      return _offsets[last] + wordLength(last) - _offsets[first];
+    }
+
+    /**
+    * @return true if the words are packed into the internal buffer
+    */
+    bool copied() const {
+      return _text == _buffer.data() && _buffer.size() > 0;
+    }
+
+    const char*        _text;        ///< The buffer holding the words
+    Vector<char>       _buffer;      ///< The packed copy of the words
+    Vector<uint32_t>   _offsets;     ///< The offset of every word in the buffer
+    Vector<uint16_t>   _lengths;     ///< The length of every word, or LONG_WORD
+    Vector<LongWord>   _longLengths; ///< The length of the long words
+    Vector<size_t>     _hashes;      ///< The hash of every word, if requested
   };
 
+  /// Words separated by spaces and null characters
+  using Words = BasicWords<>;
+
 } // end namespace Concept
 
 #endif
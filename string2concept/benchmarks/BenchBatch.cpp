@@ -0,0 +1,83 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <thread>
+#include "../ConceptExtractor.hpp"
+#include "../core/String.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../core/Vector.hpp"
+#include "../core/View.hpp"
+#include "BenchBatch.hpp"
+
+namespace Concept {
+
+  const char* BenchBatch::name() const {
+    return "Scaling Concept::ConceptExtractor batch extraction";
+  }
+
+  void BenchBatch::operator()() {
+
+    auto concepts = Benchmark::concepts(_scale);
+
+    // Short documents of 16 words
+    auto texts = Benchmark::texts(_scale / 2 + 1, 16, concepts);
+    View<String<> > inputs(texts.data(), texts.size());
+
+    ConceptExtractor extractor;
+    for (auto& concept : concepts) extractor.addConcept(concept.c_str());
+    extractor.freeze();
+
+    std::cout << "  " << concepts.size() << " concepts, " << texts.size() << " texts" << std::endl << std::endl;
+
+    size_t hardwareThreads = std::thread::hardware_concurrency();
+    if (hardwareThreads == 0) hardwareThreads = 1;
+
+    // Double the threads up to the hardware threads
+    for (size_t threadCount = 1; ; threadCount = std::min(2 * threadCount, hardwareThreads)) {
+      ThreadPool pool(threadCount);
+
+      String<> label = "batch get (16 words), threads: ";
+      label += std::to_string(threadCount).c_str();
+
+      measure(label.c_str(), texts.size(), [&]() {
+        size_t found = 0;
+        for (auto& result : extractor.get(inputs, pool)) found += result.size();
+        return found;
+      });
+
+      if (threadCount == hardwareThreads) break;
+    }
+
+    std::cout << std::endl;
+  }
+
+} //end namespace Concept
@@ -0,0 +1,158 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <string>
+#include "../AhoCorasickConceptExtractor.hpp"
+#include "../ConceptExtractor.hpp"
+#include "../NGramConceptExtractor.hpp"
+#include "../Normalizer.hpp"
+#include "../Words.hpp"
+#include "../core/String.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../core/Vector.hpp"
+#include "BenchEngines.hpp"
+
+namespace Concept {
+
+  const char* BenchEngines::name() const {
+    return "Comparing the concept extraction engines";
+  }
+
+  void BenchEngines::operator()() {
+
+    auto concepts = Benchmark::concepts(_scale);
+
+    // Texts of 16 words mixing vocabulary words and concepts
+    auto texts = Benchmark::texts(_scale / 10 + 1, 16, concepts);
+
+    std::cout << "  " << concepts.size() << " concepts, " << texts.size() << " texts" << std::endl << std::endl;
+
+    // Normalization and word splitting, shared by all engines
+    const Normalizer::Kernel kernels[] = { Normalizer::SCALAR, Normalizer::SSE42, Normalizer::AVX2 };
+    const char* kernelNames[] = { "scalar", "SSE4.2", "AVX2" };
+
+    for (size_t k = 0; k < 3; ++k) {
+      if (!Normalizer::supports(kernels[k])) continue;
+
+      measure((String<>("normalize (16 words), ") + kernelNames[k]).c_str(), texts.size(), [&]() {
+        size_t wordCount = 0;
+        Vector<uint32_t> boundaries;
+        for (auto& text : texts) {
+          Vector<char> normalized(text);
+          Normalizer::normalize(normalized, nullptr, &boundaries, kernels[k]);
+          wordCount += boundaries.size() / 2;
+        }
+        return wordCount;
+      });
+    }
+
+    // UTF-8 folding skips ASCII blocks
+    measure("normalize (16 words), accent folding", texts.size(), [&]() {
+      size_t wordCount = 0;
+      Vector<uint32_t> boundaries;
+      for (auto& text : texts) {
+        Vector<char> normalized(text);
+        BasicNormalizer<AccentInsensitiveTextPolicy>::normalize(normalized, nullptr, &boundaries);
+        wordCount += boundaries.size() / 2;
+      }
+      return wordCount;
+    });
+
+    // Splitting a whole document into a stream of word offsets and lengths, per word
+    Vector<char> document;
+    for (auto& text : texts) {
+      document += Vector<char>(text, false);
+      document.push_back(' ');
+    }
+
+    size_t documentWordCount = Words(document, false).length();
+
+    measure("split words (one document), overlay", documentWordCount, [&]() {
+      return Words(document, false).length();
+    });
+
+    measure("split words (one document), copy", documentWordCount, [&]() {
+      return Words(document).length();
+    });
+
+    std::cout << std::endl;
+
+    benchEngine<ConceptExtractor>("ConceptExtractor", concepts, texts);
+
+    // The same concepts, built at once from a concept list
+    std::string conceptList;
+    for (auto& concept : concepts) conceptList.append(concept.c_str(), concept.length()).push_back('\n');
+
+    ThreadPool pool;
+    measure("ConceptExtractor addConcepts (bulk)", concepts.size(), [&]() {
+      ConceptExtractor extractor;
+      extractor.addConcepts(View<char>(conceptList.data(), conceptList.size()), pool);
+      return extractor.conceptCount();
+    });
+
+    std::cout << std::endl;
+
+    benchEngine<NGramConceptExtractor>("NGramConceptExtractor", concepts, texts);
+    benchEngine<AhoCorasickConceptExtractor>("AhoCorasickConceptExtractor", concepts, texts);
+  }
+
+  template <typename Extractor>
+  void BenchEngines::benchEngine(const char* engineName,
+                                 const Vector<String<> >& concepts,
+                                 const Vector<String<> >& texts) {
+    Extractor extractor;
+
+    measure((String<>(engineName) + " addConcept").c_str(), concepts.size(), [&]() {
+      for (auto& concept : concepts) extractor.addConcept(concept.c_str());
+      return extractor.conceptCount();
+    });
+
+    measure((String<>(engineName) + " freeze").c_str(), concepts.size(), [&]() {
+      return static_cast<size_t>(extractor.freeze());
+    });
+
+    measure((String<>(engineName) + " get (16 words)").c_str(), texts.size(), [&]() {
+      size_t found = 0;
+      for (auto& text : texts) found += extractor.get(text).size();
+      return found;
+    });
+
+    measure((String<>(engineName) + " forEachMatch (16 words)").c_str(), texts.size(), [&]() {
+      size_t found = 0;
+      for (auto& text : texts) extractor.forEachMatch(text, [&found](const Match&) { ++found; });
+      return found;
+    });
+
+    std::cout << std::endl;
+  }
+
+} //end namespace Concept
@@ -0,0 +1,63 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_BENCH_ENGINES_HPP
+#define CONCEPT_BENCH_ENGINES_HPP
+
+#include "../core/Benchmark.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+
+namespace Concept {
+  /**
+  * Class comparing the extraction engines on the same concepts and texts
+  */
+  class BenchEngines : public Benchmark::Benchmark {
+
+  public:
+
+    const char* name() const override;
+    void operator()() override;
+
+  private:
+
+    /**
+    * Add concepts, then extract them from texts with an extraction engine
+    */
+    template <typename Extractor>
+    void benchEngine(const char* engineName,
+                     const Vector<String<> >& concepts,
+                     const Vector<String<> >& texts);
+  };
+
+} //end namespace Concept
+
+#endif
@@ -0,0 +1,122 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <algorithm>
+#include "../core/GrowthPolicy.hpp"
+#include "../core/Hash.hpp"
+#include "BenchHash.hpp"
+
+namespace Concept {
+
+  const char* BenchHash::name() const {
+    return "Comparing Concept::Hash implementations";
+  }
+
+  void BenchHash::operator()() {
+
+    auto keys = Benchmark::concepts(_scale);
+    auto words = Benchmark::words(_scale);
+
+    size_t keyBytes = 0;
+    for (auto& key : keys) keyBytes += key.length();
+
+    std::cout << "  " << keys.size() << " keys of " << std::fixed << std::setprecision(1)
+              << static_cast<double>(keyBytes) / (keys.size() ? keys.size() : 1) << " bytes on average" << std::endl;
+    std::cout << "  " << "Crc32cHash " << (Crc32cHash::hardware() ? "uses SSE 4.2" : "uses its table") << std::endl << std::endl;
+
+    benchImpl<FowlerNollVoHash>("FowlerNollVoHash", keys, words);
+    benchImpl<WyHash>("WyHash", keys, words);
+    benchImpl<Crc32cHash>("Crc32cHash", keys, words);
+    benchImpl<SipHash13>("SipHash13", keys, words);
+  }
+
+  template <typename Impl>
+  void BenchHash::benchImpl(const char* implName,
+                            const Vector<String<> >& keys,
+                            const Vector<String<> >& words) {
+    Vector<size_t> hashes;
+    hashes.reserve(keys.size());
+
+    measure((String<>(implName) + " keys").c_str(), keys.size(), [&]() {
+      size_t sum = 0;
+      for (auto& key : keys) sum += Impl()(key.c_str(), key.length());
+      return sum;
+    });
+
+    measure((String<>(implName) + " words").c_str(), words.size(), [&]() {
+      size_t sum = 0;
+      for (auto& word : words) sum += Impl()(word.c_str(), word.length());
+      return sum;
+    });
+
+    measure((String<>(implName) + " rolling keys").c_str(), keys.size(), [&]() {
+      for (auto& key : keys) hashes.push_back(RollingWordHash<Impl>()(key.c_str(), key.length()));
+      return hashes.size();
+    });
+
+    reportDistribution<PrimeGrowthPolicy>((String<>(implName) + " prime buckets").c_str(), hashes);
+    reportDistribution<PowerOfTwoGrowthPolicy>((String<>(implName) + " power of two buckets").c_str(), hashes);
+
+    std::cout << std::endl;
+  }
+
+  template <typename GrowthPolicy>
+  void BenchHash::reportDistribution(const char* label, const Vector<size_t>& keyHashes) {
+    // Concepts repeat, count each distinct key once
+    Vector<size_t> hashes = keyHashes;
+    std::sort(hashes.begin(), hashes.end());
+    hashes.resize(std::unique(hashes.begin(), hashes.end()) - hashes.begin());
+
+    GrowthPolicy policy(hashes.size());
+
+    Vector<size_t> counts;
+    counts.resize(policy.bucketCount());
+    for (size_t i = 0; i < counts.size(); ++i) counts[i] = 0;
+    for (auto hash : hashes) ++counts[policy.bucket(hash)];
+
+    // Sum of squared bucket sizes, relative to its expectation for uniform hashes: 1 is ideal
+    double squares = 0;
+    size_t longest = 0;
+    for (auto count : counts) {
+      squares += static_cast<double>(count) * count;
+      if (count > longest) longest = count;
+    }
+
+    double load = static_cast<double>(hashes.size()) / counts.size();
+    double expected = hashes.size() * (1 + load - 1.0 / counts.size());
+
+    std::cout << "  " << std::left << std::setw(48) << label << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << (expected > 0 ? squares / expected : 0) << " of ideal"
+              << std::setw(8) << longest << " longest" << std::endl;
+  }
+
+} //end namespace Concept
@@ -0,0 +1,156 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <chrono>
+#include "../ConceptExtractor.hpp"
+#include "../core/FlatHashTable.hpp"
+#include "../core/HashTable.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "BenchHashTable.hpp"
+
+namespace Concept {
+
+  const char* BenchHashTable::name() const {
+    return "Comparing Concept::HashTable and Concept::FlatHashTable";
+  }
+
+  void BenchHashTable::operator()() {
+
+    // Existing keys, and as many missing keys
+    auto concepts = Benchmark::concepts(_scale);
+    auto missingConcepts = Benchmark::concepts(_scale, 2);
+
+    Vector<Vector<char> > keys;
+    keys.reserve(concepts.size());
+    for (auto& concept : concepts) keys.push_back(Vector<char>(concept));
+
+    Vector<Vector<char> > missingKeys;
+    missingKeys.reserve(missingConcepts.size());
+    for (auto& concept : missingConcepts) {
+      String<> missingConcept = concept;
+      missingConcept += "#";
+      missingKeys.push_back(Vector<char>(missingConcept));
+    }
+
+    std::cout << "  " << keys.size() << " keys" << std::endl << std::endl;
+
+    benchTable<HashTable<Vector<char>, size_t> >("HashTable", keys, missingKeys);
+    benchTable<FlatHashTable<Vector<char>, size_t> >("FlatHashTable", keys, missingKeys);
+
+    // Texts of 16 words mixing vocabulary words and concepts
+    auto texts = Benchmark::texts(_scale / 10 + 1, 16, concepts);
+
+    benchExtractor<ConceptExtractor>("ConceptExtractor", concepts, texts);
+    benchExtractor<FlatConceptExtractor>("FlatConceptExtractor", concepts, texts);
+  }
+
+  template <typename Table>
+  void BenchHashTable::benchTable(const char* tableName,
+                                  const Vector<Vector<char> >& keys,
+                                  const Vector<Vector<char> >& missingKeys) {
+    Table table;
+
+    measure((String<>(tableName) + " insert").c_str(), keys.size(), [&]() {
+      for (size_t i = 0; i < keys.size(); ++i) table[keys[i]] = i;
+      return table.size();
+    });
+
+    // Growths are spread over insertions, or not
+    {
+      Table latencyTable;
+      double worst = 0;
+
+      for (size_t i = 0; i < keys.size(); ++i) {
+        auto start = std::chrono::steady_clock::now();
+        latencyTable[keys[i]] = i;
+        auto stop = std::chrono::steady_clock::now();
+
+        double nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+        if (nanoseconds > worst) worst = nanoseconds;
+      }
+
+      report((String<>(tableName) + " worst insert").c_str(), 1, worst);
+    }
+
+    measure((String<>(tableName) + " find existing").c_str(), keys.size(), [&]() {
+      size_t found = 0;
+      for (auto& key : keys) found += (table.find(key) != table.end());
+      return found;
+    });
+
+    measure((String<>(tableName) + " find missing").c_str(), missingKeys.size(), [&]() {
+      size_t found = 0;
+      for (auto& key : missingKeys) found += (table.find(key) != table.end());
+      return found;
+    });
+
+    std::cout << std::endl;
+  }
+
+  template <typename Extractor>
+  void BenchHashTable::benchExtractor(const char* extractorName,
+                                      const Vector<String<> >& concepts,
+                                      const Vector<String<> >& texts) {
+    Extractor extractor;
+
+    measure((String<>(extractorName) + " addConcept").c_str(), concepts.size(), [&]() {
+      for (auto& concept : concepts) extractor.addConcept(concept.c_str());
+      return concepts.size();
+    });
+
+    measure((String<>(extractorName) + " get (16 words)").c_str(), texts.size(), [&]() {
+      size_t found = 0;
+      for (auto& text : texts) found += extractor.get(text).size();
+      return found;
+    });
+
+    measure((String<>(extractorName) + " freeze").c_str(), concepts.size(), [&]() {
+      return static_cast<size_t>(extractor.freeze());
+    });
+
+    measure((String<>(extractorName) + " frozen get (16 words)").c_str(), texts.size(), [&]() {
+      size_t found = 0;
+      for (auto& text : texts) found += extractor.get(text).size();
+      return found;
+    });
+
+    measure((String<>(extractorName) + " frozen forEachMatch (16 words)").c_str(), texts.size(), [&]() {
+      size_t found = 0;
+      for (auto& text : texts) extractor.forEachMatch(text, [&found](const typename Extractor::Match&) { ++found; });
+      return found;
+    });
+
+    std::cout << std::endl;
+  }
+
+} //end namespace Concept
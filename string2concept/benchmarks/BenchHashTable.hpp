@@ -0,0 +1,70 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_BENCH_HASHTABLE_HPP
+#define CONCEPT_BENCH_HASHTABLE_HPP
+
+#include "../core/Benchmark.hpp"
+#include "../core/Vector.hpp"
+
+namespace Concept {
+  /**
+  * Class comparing the chained HashTable with the open-addressing FlatHashTable
+  */
+  class BenchHashTable : public Benchmark::Benchmark {
+
+  public:
+
+    const char* name() const override;
+    void operator()() override;
+
+  private:
+
+    /**
+    * Insert keys, then lookup existing and missing keys in a Hash table
+    */
+    template <typename Table>
+    void benchTable(const char* tableName,
+                    const Vector<Vector<char> >& keys,
+                    const Vector<Vector<char> >& missingKeys);
+
+    /**
+    * Extract concepts from texts with a concept extractor
+    */
+    template <typename Extractor>
+    void benchExtractor(const char* extractorName,
+                        const Vector<String<> >& concepts,
+                        const Vector<String<> >& texts);
+  };
+
+} //end namespace Concept
+
+#endif
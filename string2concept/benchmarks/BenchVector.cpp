@@ -0,0 +1,135 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <functional>
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "BenchVector.hpp"
+
+namespace Concept {
+
+  namespace {
+    /**
+    * The former element-by-element loops
+    */
+    void loopCopy(char* dst, const char* src, size_t len) {
+      for (size_t i = 0; i < len; ++i) dst[i] = src[i];
+    }
+
+    bool loopEqual(const char* a, const char* b, size_t len) {
+      for (size_t i = 0; i < len; ++i) if (a[i] != b[i]) return false;
+
+      return true;
+    }
+
+    const char* loopFind(const char* first, size_t len, char value, const std::function<bool(const char&, const char&)>& isEqual) {
+      for (const char* it = first; it != first + len; ++it) if (isEqual(*it, value)) return it;
+
+      return first + len;
+    }
+  }
+
+  const char* BenchVector::name() const {
+    return "Comparing Concept::Vector<char> fast paths with element loops";
+  }
+
+  void BenchVector::operator()() {
+
+    auto concepts = Benchmark::concepts(_scale);
+
+    Vector<Vector<char> > keys;
+    keys.reserve(concepts.size());
+    for (auto& concept : concepts) keys.push_back(Vector<char>(concept));
+
+    // Copies of the keys in other buffers, so that equality checks scan whole keys
+    Vector<Vector<char> > copies = keys;
+
+    std::cout << "  " << keys.size() << " keys" << std::endl << std::endl;
+
+    Vector<char> buffer;
+    buffer.reserve(4096);
+
+    measure("copy, element loop", keys.size(), [&]() {
+      size_t sum = 0;
+      for (auto& key : keys) {
+        loopCopy(buffer.data(), key.data(), key.size());
+        sum += buffer[0];
+      }
+      return sum;
+    });
+
+    measure("copy, memcpy", keys.size(), [&]() {
+      size_t sum = 0;
+      for (auto& key : keys) {
+        buffer.resize(0);
+        buffer += key;
+        sum += buffer[0];
+      }
+      return sum;
+    });
+
+    measure("equality, element loop", keys.size(), [&]() {
+      size_t equal = 0;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        equal += (keys[i].size() == copies[i].size() && loopEqual(keys[i].data(), copies[i].data(), keys[i].size()));
+      }
+      return equal;
+    });
+
+    measure("equality, memcmp", keys.size(), [&]() {
+      size_t equal = 0;
+      for (size_t i = 0; i < keys.size(); ++i) equal += (keys[i] == copies[i]);
+      return equal;
+    });
+
+    measure("find a missing byte, std::function predicate", keys.size(), [&]() {
+      std::function<bool(const char&, const char&)> isEqual = [](const char& a, const char& b) { return a == b; };
+
+      size_t found = 0;
+      for (auto& key : keys) found += (loopFind(key.data(), key.size(), '#', isEqual) != key.end());
+      return found;
+    });
+
+    measure("find a missing byte, template predicate", keys.size(), [&]() {
+      size_t found = 0;
+      for (auto& key : keys) found += (key.find('#', [](char a, char b) { return a == b; }) != key.end());
+      return found;
+    });
+
+    measure("find a missing byte, memchr", keys.size(), [&]() {
+      size_t found = 0;
+      for (auto& key : keys) found += key.contains('#');
+      return found;
+    });
+  }
+
+} //end namespace Concept
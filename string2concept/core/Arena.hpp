@@ -0,0 +1,181 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_ARENA_HPP
+#define CONCEPT_ARENA_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "Vector.hpp"
+#include "View.hpp"
+
+namespace Concept {
+
+  /**
+  * Bump allocator carving many small objects out of a few large blocks.
+  * Blocks double in size from MIN_BLOCK_SIZE up to MAX_BLOCK_SIZE, and objects larger
+  * than a quarter of a block get a block of their own.
+  * Nothing is freed one by one: all blocks are released at once by clear() or the destructor,
+  * so that the owner of millions of keys or nodes frees them in a few calls.
+  * Objects are never destroyed by the arena. Their owner destroys those that need it.
+  */
+  class Arena {
+
+  public:
+
+    static const size_t MIN_BLOCK_SIZE = 4096;
+    static const size_t MAX_BLOCK_SIZE = 1 << 20;
+
+    /**
+    * Default constructor: no block until the first allocation
+    */
+    Arena() : _cursor(nullptr), _limit(nullptr), _blockSize(MIN_BLOCK_SIZE), _size(0), _capacity(0) {}
+
+    /**
+    * Carved objects have a single owner
+    */
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+    * Destructor: release all blocks
+    */
+    ~Arena() {
+      clear();
+    }
+
+    /**
+    * Allocate uninitialized memory
+    * @param size the number of bytes
+    * @param alignment a power of two
+    * @return the memory, valid until clear()
+    */
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+      size_t padding = (alignment - reinterpret_cast<size_t>(_cursor) % alignment) % alignment;
+
+      if (_cursor == nullptr || padding + size > static_cast<size_t>(_limit - _cursor)) return allocateBlock(size, alignment);
+
+      char* result = _cursor + padding;
+      _cursor = result + size;
+      _size += size;
+
+      return result;
+    }
+
+    /**
+    * Construct an object in the arena
+    * @param args the constructor arguments
+    * @return the object, valid until clear()
+    */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+      return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+    * Copy characters to the arena
+    * @param text the characters
+    * @return a view of the copy, valid until clear()
+    */
+    View<char> copy(const View<char>& text) {
+      if (text.size() == 0) return View<char>();
+
+      char* data = static_cast<char*>(allocate(text.size(), 1));
+      memcpy(data, text.data(), text.size());
+
+      return View<char>(data, text.size());
+    }
+
+    /**
+    * Release all blocks at once
+    */
+    void clear() {
+      for (auto block : _blocks) ::operator delete(block);
+
+      _blocks = Vector<char*>();
+      _cursor = _limit = nullptr;
+      _blockSize = MIN_BLOCK_SIZE;
+      _size = _capacity = 0;
+    }
+
+    /**
+    * @return the number of bytes allocated
+    */
+    size_t size() const { return _size; }
+
+    /**
+    * @return the number of bytes of all blocks
+    */
+    size_t capacity() const { return _capacity; }
+
+  private:
+
+    /**
+    * Allocate from a new block
+    */
+    void* allocateBlock(size_t size, size_t alignment) {
+      size_t blockSize = size + alignment;
+
+      // A large object gets its own block, kept behind the current one
+      if (4 * size > _blockSize) {
+        char* block = static_cast<char*>(::operator new(blockSize));
+        _blocks.push_back(block);
+        _capacity += blockSize;
+        _size += size;
+
+        return block + (alignment - reinterpret_cast<size_t>(block) % alignment) % alignment;
+      }
+
+      char* block = static_cast<char*>(::operator new(_blockSize));
+      _blocks.push_back(block);
+      _capacity += _blockSize;
+
+      _cursor = block;
+      _limit = block + _blockSize;
+      if (_blockSize < MAX_BLOCK_SIZE) _blockSize *= 2;
+
+      return allocate(size, alignment);
+    }
+
+    Vector<char*> _blocks;
+    char*         _cursor;
+    char*         _limit;
+    size_t        _blockSize;
+    size_t        _size;
+    size_t        _capacity;
+  };
+
+} // end namespace Concept
+
+#endif
@@ -0,0 +1,251 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_BENCHMARK_HPP
+#define CONCEPT_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include "String.hpp"
+#include "Vector.hpp"
+
+namespace Concept {
+
+  namespace Benchmark
+  {
+    /// Default number of synthetic concepts
+    const size_t DEFAULT_BENCHMARK_SCALE = 1000000;
+
+    /**
+    * Abstract class defining the benchmark interface
+    */
+    class Benchmark {
+
+    public:
+
+      /**
+      * Default constructor
+      */
+      Benchmark() : _scale(DEFAULT_BENCHMARK_SCALE), _sink(0) {}
+
+      /**
+      * The benchmark name
+      */
+      virtual const char* name() const = 0;
+
+      /**
+      * The benchmark body
+      */
+      virtual void operator()() = 0;
+
+      /**
+      * Set the number of synthetic concepts
+      */
+      void scale(size_t scale) { _scale = scale; }
+
+      virtual ~Benchmark() {}
+
+    protected:
+
+      /**
+      * Time a function and report the average duration of one operation
+      * @param label what is measured
+      * @param operations the number of operations performed by one call of function
+      * @param function the measured function. It returns a value so that its work cannot be optimized out
+      * @return the average duration of an operation in nanoseconds
+      */
+      template <typename Function>
+      double measure(const char* label, size_t operations, Function function) {
+        auto start = std::chrono::steady_clock::now();
+        _sink += function();
+        auto stop = std::chrono::steady_clock::now();
+
+        return report(label, operations, std::chrono::duration<double, std::nano>(stop - start).count());
+      }
+
+      /**
+      * Report a duration measured by the benchmark itself
+      * @param label what is measured
+      * @param operations the number of operations performed
+      * @param nanoseconds their duration
+      * @return the average duration of an operation in nanoseconds
+      */
+      double report(const char* label, size_t operations, double nanoseconds) {
+        double perOperation = operations ? nanoseconds / operations : nanoseconds;
+
+        std::cout << "  " << std::left << std::setw(48) << label << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(1) << perOperation << " ns/op"
+                  << std::setw(12) << std::setprecision(1) << nanoseconds / 1e6 << " ms" << std::endl;
+
+        return perOperation;
+      }
+
+      /**
+      * Generate pseudo-random lowercase concepts of 1 to 4 words, drawn from a vocabulary
+      * of about scale / 4 words, so that words are shared among concepts as in real dictionaries.
+      * @param count the number of concepts
+      * @param seed the generator seed. The same seed yields the same concepts
+      */
+      static Vector<String<> > concepts(size_t count, uint64_t seed = 1) {
+        Vector<String<> > vocabulary = words(count / 4 + 16, seed);
+
+        Vector<String<> > result;
+        result.reserve(count);
+
+        uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+        for (size_t i = 0; i < count; ++i) {
+          // 40% of single words, then 30%, 20% and 10% of 2, 3 and 4 words
+          size_t draw = next(state) % 10;
+          size_t wordCount = draw < 4 ? 1 : draw < 7 ? 2 : draw < 9 ? 3 : 4;
+
+          String<> concept = vocabulary[next(state) % vocabulary.size()];
+          for (size_t j = 1; j < wordCount; ++j) {
+            concept += " ";
+            concept += vocabulary[next(state) % vocabulary.size()];
+          }
+
+          result.push_back(concept);
+        }
+
+        return result;
+      }
+
+      /**
+      * Generate pseudo-random texts mixing vocabulary words and concepts, one concept for four words
+      * @param count the number of texts
+      * @param wordCount the number of vocabulary words or concepts per text
+      * @param concepts the concepts to draw from
+      * @param seed the generator seed. The same seed yields the same texts
+      */
+      static Vector<String<> > texts(size_t count, size_t wordCount, const Vector<String<> >& concepts, uint64_t seed = 3) {
+        Vector<String<> > vocabulary = words(concepts.size() / 4 + 16);
+
+        Vector<String<> > result;
+        result.reserve(count);
+
+        uint64_t state = seed;
+        for (size_t i = 0; i < count; ++i) {
+          String<> text;
+          for (size_t j = 0; j < wordCount; ++j) {
+            if (j) text += " ";
+            text += (next(state) % 4 ? vocabulary[next(state) % vocabulary.size()]
+                                     : concepts[next(state) % concepts.size()]);
+          }
+          result.push_back(text);
+        }
+
+        return result;
+      }
+
+      /**
+      * Generate pseudo-random lowercase words of 3 to 10 letters
+      */
+      static Vector<String<> > words(size_t count, uint64_t seed = 1) {
+        Vector<String<> > result;
+        result.reserve(count);
+
+        uint64_t state = seed * 0xD1B54A32D192ED03ULL + 1;
+        char word[11];
+        for (size_t i = 0; i < count; ++i) {
+          size_t length = 3 + next(state) % 8;
+          for (size_t j = 0; j < length; ++j) word[j] = static_cast<char>('a' + next(state) % 26);
+          word[length] = 0;
+
+          result.push_back(String<>(word));
+        }
+
+        return result;
+      }
+
+      /**
+      * xorshift64* pseudo-random generator
+      */
+      static uint64_t next(uint64_t& state) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+      }
+
+      /// The number of synthetic concepts
+      size_t _scale;
+
+      /// Accumulate measured results
+      volatile size_t _sink;
+    };
+
+    /**
+    * Fixture for adding and running benchmarks
+    */
+    class BenchmarkFixture {
+
+    public:
+
+      /**
+      * Add a benchmark
+      */
+      void add(const std::shared_ptr<Benchmark>& benchmark) {
+        _benchmarks.push_back(benchmark);
+      }
+
+      /**
+      * Run all benchmarks
+      * @param scale the number of synthetic concepts
+      */
+      void run(size_t scale = DEFAULT_BENCHMARK_SCALE) {
+
+        size_t count = 0;
+
+        std::cout << std::endl;
+
+        for (auto& benchmark : _benchmarks) {
+
+          std::cout << "  =========== [ Benchmark " << ++count <<  " : " << benchmark->name() << " ] =========== \n" << std::endl;
+
+          benchmark->scale(scale);
+          (*benchmark)();
+
+          std::cout << std::endl << std::endl;
+        }
+      }
+
+    private:
+
+      Vector<std::shared_ptr<Benchmark> > _benchmarks;
+    };
+
+  } //end namespace Benchmark
+} // end namespace Concept
+
+#endif
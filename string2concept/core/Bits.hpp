@@ -0,0 +1,119 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_BITS_HPP
+#define CONCEPT_BITS_HPP
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Concept {
+
+  /**
+  * @return the index of the lowest set bit. mask must not be zero
+  */
+  inline unsigned countTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, static_cast<unsigned long>(mask))) return static_cast<unsigned>(index);
+    _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+    return static_cast<unsigned>(index) + 32;
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+  }
+
+  /**
+  * @return the number of set bits
+  */
+  inline unsigned countBits(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(mask));
+#else
+    mask = mask - ((mask >> 1) & 0x5555555555555555ULL);
+    mask = (mask & 0x3333333333333333ULL) + ((mask >> 2) & 0x3333333333333333ULL);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((mask * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+
+  /**
+  * @return the high 64 bits of the 128-bit product a * b
+  */
+  inline uint64_t multiplyHigh(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128_t;
+    return static_cast<uint64_t>((static_cast<uint128_t>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(a, b);
+#else
+    uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+    uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+
+    uint64_t low    = aLow * bLow;
+    uint64_t middle = aHigh * bLow + (low >> 32);
+    uint64_t carry  = (middle & 0xFFFFFFFF) + aLow * bHigh;
+
+    return aHigh * bHigh + (middle >> 32) + (carry >> 32);
+#endif
+  }
+
+  /**
+  * Map a uniformly-distributed 64-bit value to [0, range) with a multiplication instead of a modulo
+  * (Lemire's fast range reduction)
+  */
+  inline uint64_t reduceRange(uint64_t value, uint64_t range) {
+    return multiplyHigh(value, range);
+  }
+
+  /**
+  * Mix the bits of a value, so that every input bit affects every output bit
+  * (the SplitMix64 finalizer)
+  */
+  inline uint64_t mixBits(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+  }
+
+} // end namespace Concept
+
+#endif
@@ -0,0 +1,100 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_CPU_HPP
+#define CONCEPT_CPU_HPP
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CONCEPT_CPU_X86
+#endif
+
+#if defined(CONCEPT_CPU_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+// Functions using instructions beyond the compilation flags, only called once the CPU is checked
+#if defined(CONCEPT_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CONCEPT_TARGET(features) __attribute__((target(features)))
+#else
+#define CONCEPT_TARGET(features)
+#endif
+
+namespace Concept {
+
+  /**
+  * Instruction set extensions of the running CPU, checked once
+  */
+  struct CpuFeatures {
+    bool sse42; ///< SSE4.2, with SSSE3, SSE4.1 and POPCNT
+    bool avx2;  ///< AVX2, with the operating system saving the AVX registers
+
+    /**
+    * @return the features of the running CPU
+    */
+    static const CpuFeatures& get() {
+      static const CpuFeatures features = detect();
+      return features;
+    }
+
+  private:
+
+    static CpuFeatures detect() {
+      CpuFeatures features;
+      features.sse42 = false;
+      features.avx2 = false;
+
+#if defined(CONCEPT_CPU_X86) && defined(_MSC_VER)
+      int info[4];
+      __cpuid(info, 0);
+      int maxLeaf = info[0];
+
+      __cpuid(info, 1);
+      features.sse42 = (info[2] & (1 << 20)) != 0 && (info[2] & (1 << 23)) != 0;
+
+      bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+      if (maxLeaf >= 7 && osSavesAvx) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = (info[1] & (1 << 5)) != 0;
+      }
+#elif defined(CONCEPT_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+      __builtin_cpu_init();
+      features.sse42 = __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+      features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+      return features;
+    }
+  };
+
+} // end namespace Concept
+
+#endif
@@ -0,0 +1,119 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_ELEMENTS_HPP
+#define CONCEPT_ELEMENTS_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace Concept {
+
+  /**
+  * Element types whose equality is the equality of their bytes: integers, enumerations and pointers.
+  * Floating-point numbers are not, since 0.0 == -0.0 and NaN != NaN
+  */
+  template <typename T>
+  struct IsBitwiseComparable : std::integral_constant<bool, std::is_integral<T>::value ||
+                                                            std::is_enum<T>::value ||
+                                                            std::is_pointer<T>::value> {};
+
+  /**
+  * Element types searched byte by byte with memchr
+  */
+  template <typename T>
+  struct IsByteSearchable : std::integral_constant<bool, IsBitwiseComparable<T>::value && sizeof(T) == 1> {};
+
+  /**
+  * Functions on arrays of elements, specialized by type traits:
+  * arrays of bitwise-comparable or trivially copyable elements go through memcmp, memchr and memcpy.
+  */
+  namespace Elements {
+
+    template <typename T, typename U>
+    bool compareElements(const T* a, const U* b, size_t len, std::false_type) {
+      for (size_t i = 0; i < len; ++i) if (a[i] != b[i]) return false;
+
+      return true;
+    }
+
+    template <typename T>
+    bool compareElements(const T* a, const T* b, size_t len, std::true_type) {
+      return len == 0 || memcmp(a, b, len * sizeof(T)) == 0;
+    }
+
+    /**
+    * @return true if the len elements of a equal those of b
+    */
+    template <typename T, typename U>
+    bool equal(const T* a, const U* b, size_t len) {
+      return Elements::compareElements(a, b, len, std::integral_constant<bool, std::is_same<T, U>::value && IsBitwiseComparable<T>::value>());
+    }
+
+    template <typename T>
+    const T* searchElements(const T* first, size_t len, const T& value, std::false_type) {
+      for (const T* it = first; it != first + len; ++it) if (*it == value) return it;
+
+      return first + len;
+    }
+
+    template <typename T>
+    const T* searchElements(const T* first, size_t len, const T& value, std::true_type) {
+      const void* found = len ? memchr(first, static_cast<unsigned char>(value), len) : nullptr;
+
+      return found ? static_cast<const T*>(found) : first + len;
+    }
+
+    /**
+    * @return the first of len elements equal to value, or first + len
+    */
+    template <typename T>
+    const T* find(const T* first, size_t len, const T& value) {
+      return Elements::searchElements(first, len, value, IsByteSearchable<T>());
+    }
+
+    /**
+    * @return the first of len elements matching value by a predicate, or first + len.
+    * The predicate is a template parameter, so that it is inlined
+    */
+    template <typename T, typename Predicate>
+    const T* findIf(const T* first, size_t len, const T& value, Predicate isEqual) {
+      for (const T* it = first; it != first + len; ++it) if (isEqual(*it, value)) return it;
+
+      return first + len;
+    }
+
+  } // end namespace Elements
+
+} // end namespace Concept
+
+#endif
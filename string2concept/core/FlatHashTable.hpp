@@ -0,0 +1,367 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_FLATHASHTABLE_HPP
+#define CONCEPT_FLATHASHTABLE_HPP
+
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONCEPT_FLATHASHTABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "Bits.hpp"
+#include "Hash.hpp"
+
+namespace Concept {
+
+  /**
+  * Slot count of a new flat hash table.
+  * Slot counts are powers of two, so that groups are selected by masking instead of a modulo.
+  */
+  constexpr size_t DEFAULT_SMALL_FLAT_HASHTABLE_SLOT_COUNT = 1024;
+
+  /**
+  * Open-addressing Hash table, in the manner of Swiss tables.
+  * Entries are stored inline in a single slot array, along with an array of control bytes,
+  * one per slot: either EMPTY or the 7 low bits of the entry hash.
+  * Slots are probed by groups of 16: one SSE2 comparison of the group control bytes
+  * yields the candidate slots, thus most lookups touch one control group and one entry.
+  * Groups are visited along a triangular sequence, which covers all of them as their count is a power of two.
+  * Entries are never erased, hence there are no tombstones.
+  *
+  * It is a drop-in replacement for HashTable, bucketCount() being the slot count.
+  */
+  template <typename Key, typename Value, size_t SmallHashTableSlotCount = DEFAULT_SMALL_FLAT_HASHTABLE_SLOT_COUNT, typename HashType = Hash<Key>>
+  class FlatHashTable {
+
+    using Entry = std::pair<Key, Value>;
+
+  public:
+
+    static constexpr size_t GROUP_SIZE = 16;
+    static constexpr size_t MAX_BUCKET_COUNT = static_cast<size_t>(1) << (sizeof(size_t) == 8 ? 40 : 28);
+    static constexpr double LOAD_FACTOR_REHASH_THRESHOLD  = 0.875;
+
+    /**
+    * The Hash table const iterator
+    */
+    using const_iterator = const Entry*;
+
+    /**
+    * Constructor
+    */
+    FlatHashTable() : _control(nullptr), _slots(nullptr), _slotCount(0), _hashTableSize(0) {
+      allocate(roundUp(SmallHashTableSlotCount));
+    }
+
+    /**
+    * Entries are owned inline, the table is not copyable
+    */
+    FlatHashTable(const FlatHashTable&) = delete;
+    FlatHashTable& operator=(const FlatHashTable&) = delete;
+
+    /**
+    * Destructor
+    * Destroy all entries
+    */
+    ~FlatHashTable() {
+      release(_control, _slots, _slotCount);
+    }
+
+    /**
+    * @return the Hashtable load factor
+    */
+    double loadFactor() const { return static_cast<double>(_hashTableSize) / _slotCount; }
+
+    /**
+    * @return the number of elements
+    */
+    size_t size() const { return _hashTableSize; }
+
+    /**
+    * @return the number of slots
+    */
+    size_t bucketCount() const { return _slotCount; }
+
+    /***
+    * @return  an automatically-increased size
+    */
+    size_t autoResizeValue() const {
+      size_t newSize = 2 * _slotCount;
+      return  newSize <= MAX_BUCKET_COUNT  ? newSize : MAX_BUCKET_COUNT;
+    }
+
+    /**
+    * Find or create the entry at key if missing
+    * @return the entry at key
+    */
+    Value& operator[](const Key& key)
+    {
+      return insert(key, HashType()(key));
+    }
+
+    /**
+    * Find or create the entry at a key whose hash is already known
+    * @param key the key
+    * @param hash the hash of key, as computed by HashType
+    * @return the entry at key
+    */
+    Value& insert(const Key& key, size_t hash)
+    {
+      size_t slot = findSlot(key, hash);
+
+      if (slot != _slotCount) return _slots[slot].second;
+
+      // The key is missing. Extend and rehash the hash table before adding it
+      if (_hashTableSize + 1 > LOAD_FACTOR_REHASH_THRESHOLD * _slotCount) rehash(autoResizeValue());
+
+      slot = findEmptySlot(hash);
+      new (_slots + slot) Entry(key, Value());
+      _control[slot] = controlByte(hash);
+      ++_hashTableSize;
+
+      return _slots[slot].second;
+    }
+
+    /**
+    * @param key the key to search, a Key or any type comparable to Key that HashType can hash
+    * @return the entry at key or end() if missing
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key) const
+    {
+      return find(key, HashType()(key));
+    }
+
+    /**
+    * Lookup a key whose hash is already known, e.g. derived from rolling hashes.
+    * @param key the key to search, a Key or any type comparable to Key
+    * @param hash the hash of key, as computed by HashType
+    * @return the entry at key or end() if missing
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key, size_t hash) const
+    {
+      return _slots + findSlot(key, hash);
+    }
+
+    /**
+    * Extend and rehash.
+    * Entries are moved, not copied.
+    * @param newBucketCount the requested slot count, rounded up to a power of two
+    * @note the table size can only be increased
+    */
+    void rehash(size_t newBucketCount) {
+      newBucketCount = roundUp(newBucketCount);
+      if (newBucketCount <= _slotCount) return;
+
+      int8_t* oldControl   = _control;
+      Entry*  oldSlots     = _slots;
+      size_t  oldSlotCount = _slotCount;
+
+      allocate(newBucketCount);
+
+      for (size_t i = 0; i < oldSlotCount; ++i) {
+        if (oldControl[i] == EMPTY) continue;
+
+        size_t hash = HashType()(oldSlots[i].first);
+        size_t slot = findEmptySlot(hash);
+
+        new (_slots + slot) Entry(std::move(oldSlots[i]));
+        _control[slot] = controlByte(hash);
+      }
+
+      release(oldControl, oldSlots, oldSlotCount);
+    }
+
+    /**
+    * Size the table once for a number of entries, so that inserting them does not rehash
+    * @param entryCount the expected number of entries
+    */
+    void reserve(size_t entryCount) {
+      rehash(static_cast<size_t>(entryCount / LOAD_FACTOR_REHASH_THRESHOLD) + 1);
+    }
+
+    /**
+    * Visit every entry
+    * @param visit a function taking an entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+      for (size_t i = 0; i < _slotCount; ++i) {
+        if (_control[i] != EMPTY) visit(_slots[i]);
+      }
+    }
+
+    /**
+    * Visit every entry
+    * @param visit a function taking a constant entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+      for (size_t i = 0; i < _slotCount; ++i) {
+        if (_control[i] != EMPTY) visit(static_cast<const Entry&>(_slots[i]));
+      }
+    }
+
+    /**
+    * Remove all entries and shrink back to the initial slot count
+    */
+    void clear() {
+      release(_control, _slots, _slotCount);
+      _hashTableSize = 0;
+      allocate(roundUp(SmallHashTableSlotCount));
+    }
+
+    /**
+    * @return a constant iterator positioned above the last entry
+    */
+    const_iterator end() const
+    {
+      return _slots + _slotCount;
+    }
+
+  private:
+
+    /// Control byte of a free slot. Full slots hold non-negative control bytes
+    static constexpr int8_t EMPTY = -128;
+
+    /**
+    * @return the control byte of a hash, its 7 low bits
+    */
+    static int8_t controlByte(size_t hash) {
+      return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    /**
+    * @return a bitmask of the slots of a group whose control byte is value
+    */
+    static uint32_t match(const int8_t* group, int8_t value) {
+#if defined(CONCEPT_FLATHASHTABLE_SSE2)
+      __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(value))));
+#else
+      uint32_t mask = 0;
+      for (size_t i = 0; i < GROUP_SIZE; ++i) mask |= static_cast<uint32_t>(group[i] == value) << i;
+      return mask;
+#endif
+    }
+
+    /**
+    * @return the slot holding key or _slotCount if missing
+    */
+    template <typename LookupKey>
+    size_t findSlot(const LookupKey& key, size_t hash) const {
+      int8_t control = controlByte(hash);
+      size_t groupMask = _slotCount / GROUP_SIZE - 1;
+      size_t group = (hash >> 7) & groupMask;
+
+      for (size_t step = 1; ; ++step) {
+        const int8_t* groupControl = _control + group * GROUP_SIZE;
+
+        // Compare entries only where the control byte matches
+        for (uint32_t candidates = match(groupControl, control); candidates; candidates &= candidates - 1) {
+          size_t slot = group * GROUP_SIZE + countTrailingZeros(candidates);
+          if (_slots[slot].first == key) return slot;
+        }
+
+        // A free slot ends the probe sequence
+        if (match(groupControl, EMPTY)) return _slotCount;
+
+        group = (group + step) & groupMask;
+      }
+    }
+
+    /**
+    * @return the first free slot along the probe sequence of hash
+    */
+    size_t findEmptySlot(size_t hash) const {
+      size_t groupMask = _slotCount / GROUP_SIZE - 1;
+      size_t group = (hash >> 7) & groupMask;
+
+      for (size_t step = 1; ; ++step) {
+        uint32_t empty = match(_control + group * GROUP_SIZE, EMPTY);
+        if (empty) return group * GROUP_SIZE + countTrailingZeros(empty);
+
+        group = (group + step) & groupMask;
+      }
+    }
+
+    /**
+    * @return the smallest power-of-two slot count holding at least slotCount slots
+    */
+    static size_t roundUp(size_t slotCount) {
+      size_t result = GROUP_SIZE;
+      while (result < slotCount && result < MAX_BUCKET_COUNT) result *= 2;
+      return result;
+    }
+
+    /**
+    * Allocate empty storage for slotCount slots
+    */
+    void allocate(size_t slotCount) {
+      _control = new int8_t[slotCount];
+      for (size_t i = 0; i < slotCount; ++i) _control[i] = EMPTY;
+
+      // Entries are constructed in place on insertion
+      _slots = static_cast<Entry*>(::operator new(slotCount * sizeof(Entry)));
+      _slotCount = slotCount;
+    }
+
+    /**
+    * Destroy the entries and free the storage
+    */
+    static void release(int8_t* control, Entry* slots, size_t slotCount) {
+      for (size_t i = 0; i < slotCount; ++i) {
+        if (control[i] != EMPTY) slots[i].~Entry();
+      }
+
+      ::operator delete(slots);
+      delete[] control;
+    }
+
+    /// One control byte per slot
+    int8_t* _control;
+
+    /// Inline entries
+    Entry*  _slots;
+
+    size_t  _slotCount;
+    size_t  _hashTableSize;
+  };
+
+} // end namespace Concept
+
+#endif
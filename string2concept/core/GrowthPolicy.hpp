@@ -0,0 +1,170 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_GROWTHPOLICY_HPP
+#define CONCEPT_GROWTHPOLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Bits.hpp"
+
+namespace Concept {
+
+  /**
+  * A prime bucket count, and its magic number for Lemire's fastmod:
+  * with magic = ceil(2^64 / prime), a % prime is the high half of (magic * a mod 2^64) * prime,
+  * for any 32-bit a. Two multiplications replace a division.
+  */
+  struct PrimeBucketCount {
+    constexpr PrimeBucketCount(uint32_t prime) : prime(prime), magic(UINT64_C(0xFFFFFFFFFFFFFFFF) / prime + 1) {}
+
+    uint32_t prime;
+    uint64_t magic;
+  };
+
+  /**
+  * Primes roughly doubling from one to the next, each far from powers of two
+  */
+  constexpr PrimeBucketCount PRIME_BUCKET_COUNTS[] = {
+    2, 5, 11, 23, 53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317,
+    196613, 393241, 786433, 1572869, 3145739, 6291469, 12582917, 25165843, 50331653,
+    100663319, 201326611, 402653189, 805306457, 1610612741
+  };
+
+  /**
+  * Growth policy of prime bucket counts, taken from PRIME_BUCKET_COUNTS.
+  * Every hash bit matters, as the count has no factor.
+  * The hash is folded to 32 bits, then reduced with the precomputed fastmod magic number.
+  */
+  class PrimeGrowthPolicy {
+
+  public:
+
+    /**
+    * Constructor
+    * @param bucketCount the minimum bucket count, up to the largest prime of the table
+    */
+    explicit PrimeGrowthPolicy(size_t bucketCount = 0) : _index(0) {
+      while (_index + 1 < COUNT && PRIME_BUCKET_COUNTS[_index].prime < bucketCount) ++_index;
+
+      _prime = PRIME_BUCKET_COUNTS[_index].prime;
+      _magic = PRIME_BUCKET_COUNTS[_index].magic;
+    }
+
+    /**
+    * @return the number of buckets
+    */
+    size_t bucketCount() const {
+      return _prime;
+    }
+
+    /**
+    * @return the bucket of a hash, in [0, bucketCount())
+    */
+    size_t bucket(size_t hash) const {
+      uint64_t value = static_cast<uint64_t>(hash);
+      uint32_t folded = static_cast<uint32_t>(value ^ (value >> 32));
+
+      return static_cast<size_t>(multiplyHigh(_magic * folded, _prime));
+    }
+
+    /**
+    * @return the policy of the next bucket count, or the same one at the largest count
+    */
+    PrimeGrowthPolicy grown() const {
+      return PrimeGrowthPolicy(static_cast<size_t>(_prime) + 1);
+    }
+
+  private:
+
+    static const size_t COUNT = sizeof(PRIME_BUCKET_COUNTS) / sizeof(PRIME_BUCKET_COUNTS[0]);
+
+    size_t   _index;
+    uint32_t _prime;
+    uint64_t _magic;
+  };
+
+  /**
+  * Growth policy of power of two bucket counts.
+  * The hash is multiplied by the golden ratio, which mixes its bits upwards,
+  * then its high bits select the bucket (multiply-shift reduction): no division,
+  * and hashes differing only by their high bits or by multiples of the count still spread.
+  */
+  class PowerOfTwoGrowthPolicy {
+
+  public:
+
+    static const size_t MAX_SHIFT = 63;
+    static const size_t MIN_SHIFT = 64 - 8 * sizeof(size_t) + 1;
+
+    /**
+    * Constructor
+    * @param bucketCount the minimum bucket count
+    */
+    explicit PowerOfTwoGrowthPolicy(size_t bucketCount = 0) : _shift(MAX_SHIFT) {
+      while (_shift > MIN_SHIFT && this->bucketCount() < bucketCount) --_shift;
+    }
+
+    /**
+    * @return the number of buckets
+    */
+    size_t bucketCount() const {
+      return static_cast<size_t>(UINT64_C(1) << (64 - _shift));
+    }
+
+    /**
+    * @return the bucket of a hash, in [0, bucketCount())
+    */
+    size_t bucket(size_t hash) const {
+      return static_cast<size_t>((static_cast<uint64_t>(hash) * GOLDEN_RATIO) >> _shift);
+    }
+
+    /**
+    * @return the policy of twice the bucket count, or the same one at the largest count
+    */
+    PowerOfTwoGrowthPolicy grown() const {
+      PowerOfTwoGrowthPolicy result(*this);
+      if (result._shift > MIN_SHIFT) --result._shift;
+
+      return result;
+    }
+
+  private:
+
+    static const uint64_t GOLDEN_RATIO = UINT64_C(0x9E3779B97F4A7C15);
+
+    unsigned _shift;
+  };
+
+} // end namespace Concept
+
+#endif
@@ -34,8 +34,21 @@
 
 
 
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <random>
+#include <type_traits>
+#include "Bits.hpp"
+#include "Cpu.hpp"
 #include "Vector.hpp"
+#include "View.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CONCEPT_HASH_CRC32C_X64
+#include <nmmintrin.h>
+#endif
 
 namespace Concept {
 
@@ -65,6 +78,26 @@ namespace Concept {
     size_t operator()(const Vector<char, N>& key) const {
       return Impl()(key.data(), key.size());
     }
+
+    /**
+    * Hash a view consistently with Vectors, for lookups without a key copy
+    */
+    size_t operator()(const View<char>& key) const {
+      return Impl()(key.data(), key.size());
+    }
+  };
+
+  /**
+  * Hash functor for character views
+  */
+  template <typename Impl>
+  class Hash<View<char>, Impl> {
+
+  public:
+
+    size_t operator()(const View<char>& key) const {
+      return Impl()(key.data(), key.size());
+    }
   };
 
 
@@ -76,34 +109,386 @@ namespace Concept {
 
   public:
 
-    /**
-    * Constructor: set the algorithm parameters for 32 bits and 64 bit cases
-    */
-    FowlerNollVoHash() :
-      _prime (static_cast<size_t>(sizeof(size_t) == 8 ? 1099511628211ULL
-                                                      : 16777619U)),
-      _offsetBasis(static_cast<size_t>(sizeof(size_t) == 8 ? 14695981039346656037ULL
-                                                           : 2166136261U))
-     {}
+    /// The algorithm parameters for 32 bits and 64 bit cases, constant so that a functor costs nothing to build
+    static constexpr size_t PRIME        = static_cast<size_t>(sizeof(size_t) == 8 ? 1099511628211ULL
+                                                                                   : 16777619U);
+    static constexpr size_t OFFSET_BASIS = static_cast<size_t>(sizeof(size_t) == 8 ? 14695981039346656037ULL
+                                                                                   : 2166136261U);
 
     /**
     * Returned value
     */
     size_t operator()(const char* buffer, size_t len) const {
-      size_t result = _offsetBasis;
+      size_t result = OFFSET_BASIS;
 
       for (size_t i = 0; i < len; ++i) {
         result ^= static_cast<size_t>(buffer[i]);
-        result *= _prime;
+        result *= PRIME;
+      }
+
+      return result;
+    }
+  };
+
+  /**
+  * A hash in the manner of wyhash and xxh3, reading 8 bytes at a time.
+  * Keys of up to 16 bytes, most words, are read with at most four overlapping loads
+  * and mixed by a single 64x64 to 128-bit multiplication; longer keys are consumed 16 bytes per multiplication.
+  * Values assume a little-endian machine.
+  * https://github.com/wangyi-fudan/wyhash
+  */
+  class WyHash {
+
+  public:
+
+    /**
+    * Returned value
+    */
+    size_t operator()(const char* buffer, size_t len) const {
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer);
+      uint64_t seed = SECRET0;
+      uint64_t a, b;
+
+      if (len <= 16) {
+        if (len >= 4) {
+          size_t shift = (len >> 3) << 2;
+          a = (read4(p) << 32) | read4(p + shift);
+          b = (read4(p + len - 4) << 32) | read4(p + len - 4 - shift);
+        } else if (len > 0) {
+          a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+          b = 0;
+        } else {
+          a = b = 0;
+        }
+      } else {
+        size_t i = len;
+        for (; i > 16; i -= 16, p += 16) seed = mix(read8(p) ^ SECRET1, read8(p + 8) ^ seed);
+
+        a = read8(p + i - 16);
+        b = read8(p + i - 8);
+      }
+
+      return static_cast<size_t>(mix(SECRET1 ^ len, mix(a ^ SECRET1, b ^ seed)));
+    }
+
+  private:
+
+    static constexpr uint64_t SECRET0 = 0xA0761D6478BD642FULL;
+    static constexpr uint64_t SECRET1 = 0xE7037ED1A0B428DBULL;
+
+    /**
+    * @return the 128-bit product of a and b, its halves folded together
+    */
+    static uint64_t mix(uint64_t a, uint64_t b) {
+      return (a * b) ^ multiplyHigh(a, b);
+    }
+
+    static uint64_t read8(const unsigned char* p) {
+      uint64_t value;
+      memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    static uint64_t read4(const unsigned char* p) {
+      uint32_t value;
+      memcpy(&value, p, sizeof(value));
+      return value;
+    }
+  };
+
+  /**
+  * A hash built on the CRC32C (Castagnoli) checksum, computed 8 bytes per instruction with SSE 4.2
+  * when the processor supports it, checked once at runtime, otherwise by a table lookup per byte.
+  * Both paths yield the same values. The 32-bit checksum and the length are mixed into a size_t,
+  * so that every bit of the hash depends on the key.
+  */
+  class Crc32cHash {
+
+  public:
+
+    /**
+    * Returned value
+    */
+    size_t operator()(const char* buffer, size_t len) const {
+      return static_cast<size_t>(mixBits((static_cast<uint64_t>(len) << 32) | checksum(buffer, len)));
+    }
+
+    /**
+    * @return the CRC32C checksum of a buffer
+    */
+    static uint32_t checksum(const char* buffer, size_t len) {
+#if defined(CONCEPT_HASH_CRC32C_X64)
+      static const bool HARDWARE = hardware();
+      if (HARDWARE) return hardwareChecksum(buffer, len);
+#endif
+      return softwareChecksum(buffer, len);
+    }
+
+    /**
+    * @return true if the processor computes CRC32C checksums
+    */
+    static bool hardware() {
+#if defined(CONCEPT_HASH_CRC32C_X64)
+      return CpuFeatures::get().sse42;
+#else
+      return false;
+#endif
+    }
+
+    /**
+    * @return the CRC32C checksum of a buffer, computed byte by byte from a table
+    */
+    static uint32_t softwareChecksum(const char* buffer, size_t len) {
+      static const Table TABLE;
+
+      uint32_t crc = 0xFFFFFFFFU;
+      for (size_t i = 0; i < len; ++i) crc = TABLE.entries[(crc ^ static_cast<unsigned char>(buffer[i])) & 0xFF] ^ (crc >> 8);
+
+      return ~crc;
+    }
+
+#if defined(CONCEPT_HASH_CRC32C_X64)
+    /**
+    * @return the CRC32C checksum of a buffer, computed with SSE 4.2. The processor must support it
+    */
+    CONCEPT_TARGET("sse4.2")
+    static uint32_t hardwareChecksum(const char* buffer, size_t len) {
+      uint64_t crc = 0xFFFFFFFFU;
+
+      for (; len >= 8; len -= 8, buffer += 8) {
+        uint64_t value;
+        memcpy(&value, buffer, sizeof(value));
+        crc = _mm_crc32_u64(crc, value);
+      }
+
+      uint32_t result = static_cast<uint32_t>(crc);
+      if (len >= 4) {
+        uint32_t value;
+        memcpy(&value, buffer, sizeof(value));
+        result = _mm_crc32_u32(result, value);
+        len -= 4;
+        buffer += 4;
+      }
+      if (len >= 2) {
+        uint16_t value;
+        memcpy(&value, buffer, sizeof(value));
+        result = _mm_crc32_u16(result, value);
+        len -= 2;
+        buffer += 2;
+      }
+      if (len > 0) result = _mm_crc32_u8(result, static_cast<unsigned char>(*buffer));
+
+      return ~result;
+    }
+#endif
+
+  private:
+
+    /**
+    * The checksums of every byte, for the reflected polynomial 0x82F63B78
+    */
+    struct Table {
+      Table() {
+        for (uint32_t i = 0; i < 256; ++i) {
+          uint32_t crc = i;
+          for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1)));
+          entries[i] = crc;
+        }
+      }
+
+      uint32_t entries[256];
+    };
+  };
+
+  /**
+  * The SipHash keyed hash function, with its number of compression and finalization rounds
+  * https://www.aumasson.jp/siphash/siphash.pdf
+  *
+  * Without the key, inputs whose hashes collide cannot be crafted, which defeats hash flooding.
+  * Default-constructed functors share a key drawn at random once per process:
+  * hashes then differ from one process to the next, so they must not be stored
+  * (compiled dictionaries reject them on load).
+  */
+  template <unsigned CompressionRounds, unsigned FinalizationRounds>
+  class SipHash {
+
+  public:
+
+    /**
+    * A 128-bit key
+    */
+    struct Key {
+      uint64_t key0;
+      uint64_t key1;
+    };
+
+    /**
+    * Constructor with the key of the process
+    */
+    SipHash() : _key(processKey()) {}
+
+    /**
+    * Constructor with a given key, for reproducible hashes
+    */
+    SipHash(uint64_t key0, uint64_t key1) : _key{key0, key1} {}
+
+    /**
+    * Returned value
+    */
+    size_t operator()(const char* buffer, size_t len) const {
+      uint64_t v0 = _key.key0 ^ 0x736F6D6570736575ULL;
+      uint64_t v1 = _key.key1 ^ 0x646F72616E646F6DULL;
+      uint64_t v2 = _key.key0 ^ 0x6C7967656E657261ULL;
+      uint64_t v3 = _key.key1 ^ 0x7465646279746573ULL;
+
+      const unsigned char* p = reinterpret_cast<const unsigned char*>(buffer);
+      const unsigned char* blocksEnd = p + (len & ~static_cast<size_t>(7));
+
+      for (; p != blocksEnd; p += 8) {
+        uint64_t block = read8(p);
+        v3 ^= block;
+        for (unsigned i = 0; i < CompressionRounds; ++i) round(v0, v1, v2, v3);
+        v0 ^= block;
+      }
+
+      // The last block holds the remaining bytes and the length modulo 256
+      uint64_t block = static_cast<uint64_t>(len) << 56;
+      for (size_t i = 0; i < (len & 7); ++i) block |= static_cast<uint64_t>(p[i]) << (8 * i);
+
+      v3 ^= block;
+      for (unsigned i = 0; i < CompressionRounds; ++i) round(v0, v1, v2, v3);
+      v0 ^= block;
+
+      v2 ^= 0xFF;
+      for (unsigned i = 0; i < FinalizationRounds; ++i) round(v0, v1, v2, v3);
+
+      return static_cast<size_t>(v0 ^ v1 ^ v2 ^ v3);
+    }
+
+    /**
+    * @return the key of the process, drawn from the system random source and the clock on first use
+    */
+    static const Key& processKey() {
+      static const Key KEY = randomKey();
+      return KEY;
+    }
+
+  private:
+
+    static Key randomKey() {
+      std::random_device device;
+      uint64_t time = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+
+      Key key;
+      key.key0 = ((static_cast<uint64_t>(device()) << 32) | device()) ^ time;
+      key.key1 = ((static_cast<uint64_t>(device()) << 32) | device()) ^ mixBits(time);
+      return key;
+    }
+
+    static uint64_t rotate(uint64_t value, unsigned bits) {
+      return (value << bits) | (value >> (64 - bits));
+    }
+
+    static void round(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+      v0 += v1; v1 = rotate(v1, 13); v1 ^= v0; v0 = rotate(v0, 32);
+      v2 += v3; v3 = rotate(v3, 16); v3 ^= v2;
+      v0 += v3; v3 = rotate(v3, 21); v3 ^= v0;
+      v2 += v1; v1 = rotate(v1, 17); v1 ^= v2; v2 = rotate(v2, 32);
+    }
+
+    static uint64_t read8(const unsigned char* p) {
+      uint64_t value;
+      memcpy(&value, p, sizeof(value));
+      return value;
+    }
+
+    Key _key;
+  };
+
+  /**
+  * SipHash-1-3: fast enough for hash tables, still keyed
+  */
+  using SipHash13 = SipHash<1, 3>;
+
+  /**
+  * Whether a hash function draws its key once per process, so that its hashes must not be stored
+  */
+  template <typename Impl>
+  struct IsSeededHash : std::false_type {};
+
+  template <unsigned CompressionRounds, unsigned FinalizationRounds>
+  struct IsSeededHash<SipHash<CompressionRounds, FinalizationRounds> > : std::true_type {};
+
+  /**
+  * Composable hash over sequences of space-separated words, in the manner of Rabin-Karp.
+  * Every word is hashed once by WordImpl, then word hashes are combined
+  * as a polynomial in BASE (modulo the size_t range):
+  * H(w1 ... wn) = h(w1) * BASE^(n-1) + ... + h(wn-1) * BASE + h(wn)
+  *
+  * Given the prefix hashes P(i) = H(w1 ... wi) of a text, the hash of any span of words
+  * is derived in constant time : H(wi+1 ... wj) = P(j) - P(i) * BASE^(j-i).
+  * The hash of a single word is the word hash itself.
+  */
+  template <typename WordImpl = FowlerNollVoHash>
+  class RollingWordHash {
+
+  public:
+
+    /// An odd multiplier, thus invertible modulo the size_t range
+    static constexpr size_t BASE = static_cast<size_t>(sizeof(size_t) == 8 ? 0x9E3779B97F4A7C15ULL
+                                                                           : 0x9E3779B9U);
+
+    /**
+    * Hash a sequence of words.
+    * Runs of separators are skipped, they do not contribute to the hash.
+    */
+    size_t operator()(const char* buffer, size_t len) const {
+      size_t result = 0;
+      size_t wordStart = 0;
+
+      for (size_t i = 0; i <= len; ++i) {
+        if (i < len && !isSeparator(buffer[i])) continue;
+
+        if (i > wordStart) result = combine(result, word(buffer + wordStart, i - wordStart));
+        wordStart = i + 1;
       }
 
       return result;
     }
 
+    /**
+    * @return the hash of a single word
+    */
+    static size_t word(const char* buffer, size_t len) {
+      return WordImpl()(buffer, len);
+    }
+
+    /**
+    * Append a word hash to the hash of the preceding words
+    * @return the hash of the extended sequence
+    */
+    static size_t combine(size_t prefixHash, size_t wordHash) {
+      return prefixHash * BASE + wordHash;
+    }
+
+    /**
+    * Hash of the words between two prefixes
+    * @param prefixHash the hash of the words preceding the span
+    * @param extendedHash the hash of the same words followed by the span
+    * @param basePower BASE raised to the number of words in the span
+    */
+    static size_t span(size_t prefixHash, size_t extendedHash, size_t basePower) {
+      return extendedHash - prefixHash * basePower;
+    }
+
   private:
 
-    const size_t _prime;
-    const size_t _offsetBasis;
+    /**
+    * @return true if ch separates words
+    */
+    static bool isSeparator(char ch) {
+      return ch == ' ' || ch == 0;
+    }
   };
 
 } // end namespace Concept
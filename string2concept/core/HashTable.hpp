@@ -32,28 +32,37 @@
 #ifndef CONCEPT_HASHTABLE_HPP
 #define CONCEPT_HASHTABLE_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
 #include <limits>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 
+#include "Arena.hpp"
+#include "GrowthPolicy.hpp"
 #include "Hash.hpp"
 #include "String.hpp"
 
 namespace Concept {
 
   /**
-  * Verify that n prime, stating from l, at compile time
+  * Verify that n prime, stating from l, at compile time when n is a constant expression
   * Must not exceed 512 iterations due to compiler limitations.
   */
-  inline bool isPrime(size_t n, size_t l) {
+  constexpr bool isPrime(size_t n, size_t l) {
     return l * l > n || (n % l && n % (l + 2) && isPrime(n , l + 6)); 
   }
 
   /**
-  * Compute the next prime after n, at compile time
+  * Compute the next prime after n, at compile time when n is a constant expression
   */
-  inline size_t nextPrimeFrom(size_t n) {
+  constexpr size_t nextPrimeFrom(size_t n) {
    return (n == 2 || n == 3 || (n % 2 && n % 3 && isPrime(n, 5))) ? n : nextPrimeFrom(n + 1);
   }
 
@@ -70,40 +79,82 @@ namespace Concept {
   /**
   * Class Hash table
   * The default Hash function behind the Hash class is Fowler-Noll-Vo. 
+  * Lookups are heterogeneous: any type that HashType can hash consistently with Key,
+  * and that compares equal to Key, can be searched without building a Key.
+  * Buckets chain nodes carved from an Arena: inserting costs no heap allocation of its own,
+  * rehashing relinks the nodes, and destroying the table releases a few blocks,
+  * after destroying the entries unless they are trivially destructible.
+  * Nodes cache the full hash of their key: lookups compare keys only when hashes are equal,
+  * and rehashing neither hashes keys again nor moves entries.
+  *
+  * Growth is incremental: once the load factor threshold is reached, a larger bucket index
+  * replaces the current one, which is kept aside while every insertion migrates
+  * MIGRATION_STEP of its buckets, plus the bucket of the inserted key.
+  * Lookups consult both indexes meanwhile. Thus no insertion relinks more than a few buckets,
+  * and the migration ends long before the next growth. rehash() and reserve() still complete at once.
+  *
+  * Bucket counts and the reduction of hashes to buckets follow the GrowthPolicy:
+  * PrimeGrowthPolicy, prime counts with fastmod, or PowerOfTwoGrowthPolicy, with multiply-shift.
+  * Neither divides on lookups.
+  *
+  * Chains stay short: a bucket reaching MAX_CHAIN_LENGTH nodes is converted to an array
+  * of its nodes sorted by hash, searched by bisection. Lookups thus stay logarithmic
+  * even when crafted keys fill a bucket, as long as their full hashes differ,
+  * which a keyed HashType such as SipHash13 guarantees.
   */
-  template <typename Key, typename Value, size_t SmallHashTableBucketCount = DEFAULT_SMALL_HASHTABLE_BUCKET_COUNT, typename HashType = Hash<Key>>
+  template <typename Key, typename Value, size_t SmallHashTableBucketCount = DEFAULT_SMALL_HASHTABLE_BUCKET_COUNT, typename HashType = Hash<Key>,
+            typename GrowthPolicy = PrimeGrowthPolicy>
   class HashTable {
 
     using Entry = std::pair<Key, Value>;
-    using Bucket = Vector<Entry>;
+
+    /**
+    * Chained entry, with the full hash of its key
+    */
+    struct Node {
+      Node(const Key& key, size_t hash) : entry(key, Value()), hash(hash), next(nullptr) {}
+
+      Entry  entry;
+      size_t hash;
+      Node*  next;
+    };
 
   public:
 
-    static constexpr size_t MAX_BUCKET_COUNT = 1000000007; // A billion
     static constexpr double LOAD_FACTOR_REHASH_THRESHOLD  = 0.8;
 
+    /// Number of buckets migrated by every insertion during a growth
+    static constexpr size_t MIGRATION_STEP = 8;
+
+    /// Number of nodes from which a chain is converted to a sorted bucket
+    static constexpr size_t MAX_CHAIN_LENGTH = 8;
+
     /**
     * The Hash table const iterator
     */
-    using const_iterator = typename Bucket::const_iterator;
+    using const_iterator = const Entry*;
 
     /**
     * Constructor
     */
     HashTable() :
-        _hashTableSize(0) {
+        _hashTableSize(0), _migratedBucketCount(0) {
             // Initialize buckets
-            size_t bucketCount = nextPrimeFrom(SmallHashTableBucketCount);
-
-            for (size_t i = 0; i < bucketCount; ++i) _storage.push_back(nullptr);
+            _storage.allocate(GrowthPolicy(SmallHashTableBucketCount));
         } 
 
+    /**
+    * The nodes have a single owner
+    */
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
+
     /**
     * Destructor
-    * Delete all uckets
+    * Destroy the entries, then the arena releases the nodes
     */
     ~HashTable() {
-        for (auto& bucket : _storage) delete bucket;
+        destroyEntries();
     }
 
     /**
@@ -125,8 +176,7 @@ namespace Concept {
     * @return  an automatically-increased size
     */
     size_t autoResizeValue() const {
-        size_t newSize = 2 * _storage.size();
-        return  newSize <= MAX_BUCKET_COUNT  ? newSize : MAX_BUCKET_COUNT;   
+        return _storage.policy().grown().bucketCount();
     }
     
     /**
@@ -135,92 +185,146 @@ namespace Concept {
     */
     Value& operator[](const Key& key)
     {
-     // Extend and rehash the hash table
-     if (loadFactor() >= LOAD_FACTOR_REHASH_THRESHOLD) rehash(autoResizeValue());
+      return insert(key, HashType()(key));
+    }
 
-     // Find the bucket for that key
-     size_t bucketIndex = HashType()(key) % _storage.size();
-      auto& bucket = _storage[bucketIndex];
+    /**
+    * Find or create the entry at a key whose hash is already known
+    * @param key the key
+    * @param hash the hash of key, as computed by HashType
+    * @return the entry at key
+    */
+    Value& insert(const Key& key, size_t hash)
+    {
+     // Carry on a growth, or extend the hash table
+     if (migrating()) {
+       migrate(MIGRATION_STEP);
 
-      typename Bucket::iterator entry;
+       // The key may only be found in the new buckets
+       if (migrating()) migrateBucket(_oldStorage.bucket(hash));
 
-      if (bucket == nullptr) {
-        // The bucket is not allocated, create it
-        bucket = new Bucket();
-        entry = bucket->end();
-      } else {
-        // The bucket is not empty search for the key
-         entry = bucket->find(std::make_pair(key, Value()),
-                              [](const Entry& a, const Entry& b ){ return a.first == b.first; });
-      }
+     } else if (loadFactor() >= LOAD_FACTOR_REHASH_THRESHOLD) {
+       grow(autoResizeValue());
 
-      // The bucket does not contain the key, add it
-      if (entry == bucket->end()) {
+       if (migrating()) migrateBucket(_oldStorage.bucket(hash));
+     }
 
-        bucket->push_back(std::make_pair(key, Value()));
+     // Find the bucket for that key, then the key node
+     Node*& head = _storage[_storage.bucket(hash)];
+     Node* node = findNode(head, key, hash);
 
-        ++_hashTableSize;
+     // The bucket does not contain the key, add it
+     if (node == nullptr) {
+       node = _nodes.create<Node>(key, hash);
+       link(head, node);
 
-        entry = bucket->last();
-      }
+       ++_hashTableSize;
+     }
 
-      return entry->second;
+     return node->entry.second;
     }
 
     /**
+    * @param key the key to search, a Key or any type comparable to Key that HashType can hash
     * @return the entry at key or end() if missing
     */
-    const_iterator find(const Key& key) const
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key) const
     {
-      // Find the bucket for that key
-      size_t bucketIndex = HashType()(key) % _storage.size();
-      auto& bucket = _storage[bucketIndex];
-
-      typename Bucket::iterator entry;
-
-      if (bucket == nullptr) {
-         return end();
-      }
-      else {
-        // The bucket is not empty search for the key
-        entry = bucket->find(std::make_pair(key, Value()),
-                             [](const Entry& a, const Entry& b) { return a.first == b.first; });
+      return find(key, HashType()(key));
+    }
 
-        if (entry == bucket->end()) return end();
+    /**
+    * Lookup a key whose hash is already known, e.g. derived from rolling hashes.
+    * @param key the key to search, a Key or any type comparable to Key
+    * @param hash the hash of key, as computed by HashType
+    * @return the entry at key or end() if missing
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key, size_t hash) const
+    {
+      // Find the bucket for that key, then search it
+      const Node* node = findNode(_storage[_storage.bucket(hash)], key, hash);
 
-      }
+      // During a growth, the key may still be in the former buckets
+      if (node == nullptr && migrating()) node = findNode(_oldStorage[_oldStorage.bucket(hash)], key, hash);
 
-      return entry;
+      return node ? &node->entry : end();
     }
 
     /**
-    * Extend and rehash.
+    * Finish any growth in progress, then grow to at least a number of buckets,
+    * rounded up by the growth policy, and migrate every entry at once.
     * @note the table size can only be increased
+    * @param newBucketCount the minimum bucket count
     */
     void rehash(size_t newBucketCount) {
-        if (newBucketCount <= _storage.size()) return;
+        migrate(_oldStorage.size());
 
-        // Copy the  bucket pointers to a temporary index
-        Vector<Bucket*,
-               SmallHashTableBucketCount> tempStorage = _storage;
-       
-        // Resize the index to prevent a copy during the reserve()
-        _storage.resize(0);
-        _storage.reserve(newBucketCount);
-        for (size_t i = 0; i < newBucketCount; ++i) _storage.push_back(nullptr);
+        grow(newBucketCount);
+        migrate(_oldStorage.size());
+    }
 
-        _hashTableSize = 0;
+    /**
+    * @return true while entries migrate from the former buckets after a growth
+    */
+    bool migrating() const {
+        return _oldStorage.size() > 0;
+    }
 
-        // Move back entries to the original storage in new buckets
-        for (auto& bucket : tempStorage) {
-            if (!bucket) continue;
+    /**
+    * Size the table once for a number of entries, so that inserting them does not rehash
+    * @param entryCount the expected number of entries
+    */
+    void reserve(size_t entryCount) {
+        size_t bucketCount = static_cast<size_t>(entryCount / LOAD_FACTOR_REHASH_THRESHOLD) + 1;
+        if (bucketCount > _storage.size()) rehash(bucketCount);
+    }
 
-            for (auto& entry : *bucket) {
-                (*this)[entry.first] = entry.second;
-            }
+    /**
+    * Visit every entry
+    * @param visit a function taking an entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+      for (auto head : _storage) forEachNode(head, [&visit](Node* node) { visit(node->entry); });
+      for (auto head : _oldStorage) forEachNode(head, [&visit](Node* node) { visit(node->entry); });
+    }
 
-           delete bucket;
-        }
+    /**
+    * Visit every entry
+    * @param visit a function taking a constant entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+      for (auto head : _storage) forEachNode(head, [&visit](const Node* node) { visit(static_cast<const Entry&>(node->entry)); });
+      for (auto head : _oldStorage) forEachNode(head, [&visit](const Node* node) { visit(static_cast<const Entry&>(node->entry)); });
+    }
+
+    /**
+    * @return the number of buckets converted from chains to sorted arrays
+    */
+    size_t sortedBucketCount() const {
+      size_t count = 0;
+      for (auto head : _storage) count += isSorted(head);
+      for (auto head : _oldStorage) count += isSorted(head);
+
+      return count;
+    }
+
+    /**
+    * Remove all entries and shrink back to the initial bucket count
+    */
+    void clear() {
+      destroyEntries();
+      _nodes.clear();
+
+      _oldStorage.release();
+      _migratedBucketCount = 0;
+
+      _storage.allocate(GrowthPolicy(SmallHashTableBucketCount));
+
+      _hashTableSize = 0;
     }
 
     /**
@@ -228,18 +332,285 @@ namespace Concept {
     */
     const_iterator end() const
     {
-      return reinterpret_cast<const_iterator>(_storage.end());
+      return nullptr;
     }
 
   private:
 
    /**
-   * Internal storage, a vector of unique pointers to buckets
-   * Every bucket is a vector of pairs (key, value).
+   * Bucket index, zeroed by calloc(): the system maps large indexes lazily,
+   * so that allocating one does not touch its pages at once
+   */
+   class Storage {
+
+   public:
+
+     Storage() : _buckets(nullptr), _size(0) {}
+
+     Storage(const Storage&) = delete;
+     Storage& operator=(const Storage&) = delete;
+
+     ~Storage() {
+       free(_buckets);
+     }
+
+     /**
+     * Replace the buckets by as many empty ones as the policy counts
+     */
+     void allocate(const GrowthPolicy& policy) {
+       release();
+
+       _buckets = static_cast<Node**>(calloc(policy.bucketCount(), sizeof(Node*)));
+       if (_buckets == nullptr) throw std::bad_alloc();
+
+       _size = policy.bucketCount();
+       _policy = policy;
+     }
+
+     /**
+     * Free the buckets
+     */
+     void release() {
+       free(_buckets);
+       _buckets = nullptr;
+       _size = 0;
+     }
+
+     void swap(Storage& other) {
+       std::swap(_buckets, other._buckets);
+       std::swap(_size, other._size);
+       std::swap(_policy, other._policy);
+     }
+
+     size_t size() const { return _size; }
+
+     const GrowthPolicy& policy() const { return _policy; }
+
+     size_t bucket(size_t hash) const { return _policy.bucket(hash); }
+
+     Node*& operator[](size_t i) { return _buckets[i]; }
+     Node* operator[](size_t i) const { return _buckets[i]; }
+
+     Node** begin() const { return _buckets; }
+     Node** end() const { return _buckets + _size; }
+
+   private:
+
+     Node** _buckets;
+     size_t _size;
+     GrowthPolicy _policy;
+   };
+
+   /**
+   * Bucket converted from a chain: its nodes sorted by hash.
+   * Buckets point to it with their lowest bit set, which node addresses never have
+   */
+   struct SortedBucket {
+     Node** nodes;
+     size_t size;
+     size_t capacity;
+   };
+
+   static bool isSorted(const Node* head) {
+     return (reinterpret_cast<uintptr_t>(head) & 1) != 0;
+   }
+
+   static SortedBucket* sortedBucket(Node* head) {
+     return reinterpret_cast<SortedBucket*>(reinterpret_cast<uintptr_t>(head) & ~static_cast<uintptr_t>(1));
+   }
+
+   static Node* tagged(SortedBucket* bucket) {
+     return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(bucket) | 1);
+   }
+
+   static bool hashLess(const Node* node, size_t hash) {
+     return node->hash < hash;
+   }
+
+   static bool nodeLess(const Node* left, const Node* right) {
+     return left->hash < right->hash;
+   }
+
+   /**
+   * Search a bucket for the node at key: along its chain,
+   * or by bisection over the hashes of a sorted bucket.
+   * Keys are only compared when the cached hashes are equal
+   * @return the node or nullptr
+   */
+   template <typename LookupKey>
+   static Node* findNode(Node* head, const LookupKey& key, size_t hash) {
+     if (isSorted(head)) {
+       SortedBucket* bucket = sortedBucket(head);
+       Node** last = bucket->nodes + bucket->size;
+
+       for (Node** node = std::lower_bound(bucket->nodes, last, hash, hashLess); node != last && (*node)->hash == hash; ++node) {
+         if ((*node)->entry.first == key) return *node;
+       }
+
+       return nullptr;
+     }
+
+     for (; head != nullptr; head = head->next) {
+       if (head->hash == hash && head->entry.first == key) return head;
+     }
+
+     return nullptr;
+   }
+
+   /**
+   * Visit every node of a bucket
    */
-   Vector<Bucket*,
-          SmallHashTableBucketCount> _storage;
+   template <typename Visitor>
+   static void forEachNode(Node* head, Visitor visit) {
+     if (isSorted(head)) {
+       SortedBucket* bucket = sortedBucket(head);
+       for (size_t i = 0; i < bucket->size; ++i) visit(bucket->nodes[i]);
+       return;
+     }
+
+     for (; head != nullptr; head = head->next) visit(head);
+   }
+
+   /**
+   * Add a node to a bucket: at the end of its chain,
+   * or at its rank in a sorted bucket, converting the chain once it reaches MAX_CHAIN_LENGTH
+   */
+   void link(Node*& head, Node* node) {
+     node->next = nullptr;
+
+     if (isSorted(head)) {
+       insertSorted(*sortedBucket(head), node);
+       return;
+     }
+
+     size_t length = 0;
+     Node** tail = &head;
+     for (; *tail != nullptr; tail = &(*tail)->next) ++length;
+
+     if (length + 1 < MAX_CHAIN_LENGTH) {
+       *tail = node;
+       return;
+     }
+
+     // Convert the chain
+     SortedBucket* bucket = _nodes.create<SortedBucket>();
+     bucket->capacity = 2 * MAX_CHAIN_LENGTH;
+     bucket->nodes = static_cast<Node**>(_nodes.allocate(bucket->capacity * sizeof(Node*), alignof(Node*)));
+     bucket->size = 0;
+
+     for (Node* chained = head; chained != nullptr; chained = chained->next) bucket->nodes[bucket->size++] = chained;
+     bucket->nodes[bucket->size++] = node;
+     std::sort(bucket->nodes, bucket->nodes + bucket->size, nodeLess);
+
+     head = tagged(bucket);
+   }
+
+   /**
+   * Insert a node at its rank in a sorted bucket, doubling its array when full.
+   * Former arrays stay in the arena
+   */
+   void insertSorted(SortedBucket& bucket, Node* node) {
+     if (bucket.size == bucket.capacity) {
+       Node** nodes = static_cast<Node**>(_nodes.allocate(2 * bucket.capacity * sizeof(Node*), alignof(Node*)));
+       memcpy(nodes, bucket.nodes, bucket.size * sizeof(Node*));
+
+       bucket.nodes = nodes;
+       bucket.capacity *= 2;
+     }
+
+     Node** last = bucket.nodes + bucket.size;
+     Node** position = std::upper_bound(bucket.nodes, last, node, nodeLess);
+     memmove(position + 1, position, (last - position) * sizeof(Node*));
+
+     *position = node;
+     ++bucket.size;
+   }
+
+   /**
+   * Start a growth: the current buckets are set aside, to migrate, and new empty buckets replace them
+   * @note the table size can only be increased
+   */
+   void grow(size_t newBucketCount) {
+     GrowthPolicy policy(newBucketCount);
+     if (policy.bucketCount() <= _storage.size()) return;
+
+     // A growth only starts once the previous one ended
+     migrate(_oldStorage.size());
+
+     _oldStorage.swap(_storage);
+     _storage.allocate(policy);
+
+     _migratedBucketCount = 0;
+   }
+
+   /**
+   * Migrate the next former buckets, then release them once all migrated
+   * @param bucketCount the maximum number of buckets to migrate
+   */
+   void migrate(size_t bucketCount) {
+     for (; bucketCount > 0 && _migratedBucketCount < _oldStorage.size(); --bucketCount) {
+       migrateBucket(_migratedBucketCount++);
+     }
+
+     if (_migratedBucketCount >= _oldStorage.size() && migrating()) {
+       _oldStorage.release();
+       _migratedBucketCount = 0;
+     }
+   }
+
+   /**
+   * Relink the nodes of a former bucket in the new buckets, entries stay in place
+   * @param bucketIndex the former bucket index. Migrated buckets are empty
+   */
+   void migrateBucket(size_t bucketIndex) {
+     Node* node = _oldStorage[bucketIndex];
+     _oldStorage[bucketIndex] = nullptr;
+
+     // Sorted buckets spread over the new buckets like chains
+     if (isSorted(node)) {
+       SortedBucket* bucket = sortedBucket(node);
+       for (size_t i = 0; i < bucket->size; ++i) link(_storage[_storage.bucket(bucket->nodes[i]->hash)], bucket->nodes[i]);
+       return;
+     }
+
+     while (node) {
+       Node* next = node->next;
+       Node*& head = _storage[_storage.bucket(node->hash)];
+
+       // Prepend, unless the new bucket is sorted or would grow too long
+       if (head == nullptr || (!isSorted(head) && head->next == nullptr)) {
+         node->next = head;
+         head = node;
+       } else {
+         link(head, node);
+       }
+
+       node = next;
+     }
+   }
+
+   /**
+   * Destroy the entries that need it. Their nodes stay in the arena
+   */
+   void destroyEntries() {
+     if (std::is_trivially_destructible<Entry>::value) return;
+
+     forEach([](Entry& entry) { entry.~Entry(); });
+   }
+
+   /**
+   * Internal storage, a vector of pointers to the first node of every bucket
+   * Every bucket chains nodes of pairs (key, value).
+   */
+   Storage _storage;
    size_t _hashTableSize;
+
+   /// The former buckets during a growth, and the number of them already migrated
+   Storage _oldStorage;
+   size_t  _migratedBucketCount;
+
+   /// The nodes of all buckets
+   Arena _nodes;
   };
 
 } // end namespace Concept
@@ -0,0 +1,180 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_MAPPEDFILE_HPP
+#define CONCEPT_MAPPEDFILE_HPP
+
+#include <cstddef>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Concept {
+
+  /**
+  * Read-only memory mapping of a whole file.
+  * Pages are loaded on demand and shared among the processes mapping the same file.
+  */
+  class MappedFile {
+
+  public:
+
+    /**
+    * Default constructor: no file mapped
+    */
+    MappedFile() : _data(nullptr), _size(0) {}
+
+    /**
+    * Map a file
+    * @param path the file path
+    */
+    explicit MappedFile(const char* path) : _data(nullptr), _size(0) {
+      open(path);
+    }
+
+    /**
+    * A mapping has a single owner
+    */
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+    * Destructor: unmap the file
+    */
+    ~MappedFile() {
+      close();
+    }
+
+    /**
+    * Map a file, unmapping the previous one
+    * @param path the file path
+    * @return true if mapped. Empty files cannot be mapped.
+    */
+    bool open(const char* path) {
+      close();
+
+#if defined(_WIN32)
+      HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE) return false;
+
+      LARGE_INTEGER fileSize;
+      if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+      }
+
+      HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      CloseHandle(file);
+      if (!mapping) return false;
+
+      void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      CloseHandle(mapping);
+      if (!data) return false;
+
+      _data = static_cast<const char*>(data);
+      _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+      int file = ::open(path, O_RDONLY);
+      if (file < 0) return false;
+
+      struct stat fileStat;
+      if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0) {
+        ::close(file);
+        return false;
+      }
+
+      void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, file, 0);
+      ::close(file);
+      if (data == MAP_FAILED) return false;
+
+      _data = static_cast<const char*>(data);
+      _size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+      return true;
+    }
+
+    /**
+    * Unmap the file
+    */
+    void close() {
+      if (!_data) return;
+
+#if defined(_WIN32)
+      UnmapViewOfFile(_data);
+#else
+      munmap(const_cast<char*>(_data), _size);
+#endif
+
+      _data = nullptr;
+      _size = 0;
+    }
+
+    /**
+    * @return true if a file is mapped
+    */
+    bool isOpen() const {
+      return _data != nullptr;
+    }
+
+    /**
+    * @return the mapped bytes
+    */
+    const char* data() const {
+      return _data;
+    }
+
+    /**
+    * @return the file size
+    */
+    size_t size() const {
+      return _size;
+    }
+
+  private:
+
+    const char* _data;
+    size_t      _size;
+  };
+
+} // end namespace Concept
+
+#endif
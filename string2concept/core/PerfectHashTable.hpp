@@ -0,0 +1,400 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_PERFECTHASHTABLE_HPP
+#define CONCEPT_PERFECTHASHTABLE_HPP
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <utility>
+
+#include "Bits.hpp"
+#include "Hash.hpp"
+#include "Vector.hpp"
+
+namespace Concept {
+
+  /**
+  * Read-only Hash table over a minimal perfect hash function, built once from another table.
+  * n entries occupy exactly n slots and every key owns a distinct slot:
+  * a lookup costs one hash, one slot and one key comparison, whatever the keys.
+  *
+  * The perfect hash function follows the CHD algorithm (Compress, Hash and Displace,
+  * Belazzougui, Botelho and Dietzfelbinger):
+  * keys are split into n / AVERAGE_BUCKET_SIZE buckets. Every bucket stores a displacement (d0, d1)
+  * and its keys occupy slots (f1 + d0 * f2 + d1) mod n, where f1 and f2 derive from the key hash.
+  * Buckets are placed from the largest, searching the first displacement that lands all their keys in free slots.
+  * Single-key buckets are placed last, directly in the remaining slots.
+  *
+  * The index costs 5 bytes per bucket, i.e. 8 bits per key, on top of the entries.
+  */
+  template <typename Key, typename Value, typename HashType = Hash<Key>>
+  class PerfectHashTable {
+
+    using Entry = std::pair<Key, Value>;
+
+  public:
+
+    static constexpr size_t AVERAGE_BUCKET_SIZE = 5;
+    static constexpr size_t MAX_SEED_ATTEMPTS   = 16;
+
+    /**
+    * The Hash table const iterator
+    */
+    using const_iterator = const Entry*;
+
+    /**
+    * Default constructor: an empty table
+    */
+    PerfectHashTable() : _slots(nullptr), _hashTableSize(0), _seed(0) {}
+
+    /**
+    * Entries are owned inline, the table is not copyable
+    */
+    PerfectHashTable(const PerfectHashTable&) = delete;
+    PerfectHashTable& operator=(const PerfectHashTable&) = delete;
+
+    /**
+    * Destructor
+    */
+    ~PerfectHashTable() {
+      clear();
+    }
+
+    /**
+    * @return the number of elements
+    */
+    size_t size() const { return _hashTableSize; }
+
+    /**
+    * @return the number of buckets of the perfect hash function
+    */
+    size_t bucketCount() const { return _displacements.size(); }
+
+    /**
+    * @return the size of the perfect hash function in bits per key
+    */
+    double bitsPerKey() const {
+      if (_hashTableSize == 0) return 0;
+      return 8.0 * bucketCount() * (sizeof(uint32_t) + sizeof(uint8_t)) / _hashTableSize;
+    }
+
+    /**
+    * Build the table from the entries of another table, which are moved.
+    * The source table keeps moved-from entries: it is meant to be cleared afterwards.
+    * @param table a Hash table exposing size() and forEach()
+    * @return false if the keys could not be separated, e.g. when distinct keys have equal hashes.
+    *         The source table is then left unchanged.
+    */
+    template <typename Table>
+    bool build(Table& table) {
+      clear();
+
+      // The perfect hash function only needs the key hashes
+      Vector<uint64_t> hashes;
+      hashes.reserve(table.size());
+      table.forEach([&hashes](const Entry& entry) {
+        uint64_t hash = HashType()(entry.first);
+        hashes.push_back(hash);
+      });
+
+      if (!buildDisplacements(hashes)) return false;
+
+      // Move every entry to its slot
+      _slots = static_cast<Entry*>(::operator new(hashes.size() * sizeof(Entry)));
+      size_t i = 0;
+      table.forEach([this, &hashes, &i](Entry& entry) {
+        new (_slots + slot(hashes[i++])) Entry(std::move(entry));
+      });
+
+      return true;
+    }
+
+    /**
+    * @param key the key to search, a Key or any type comparable to Key that HashType can hash
+    * @return the entry at key or end() if missing
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key) const
+    {
+      return find(key, HashType()(key));
+    }
+
+    /**
+    * Lookup a key whose hash is already known, e.g. derived from rolling hashes.
+    * @param key the key to search, a Key or any type comparable to Key
+    * @param hash the hash of key, as computed by HashType
+    * @return the entry at key or end() if missing
+    */
+    template <typename LookupKey>
+    const_iterator find(const LookupKey& key, size_t hash) const
+    {
+      if (_hashTableSize == 0) return end();
+
+      // A missing key also maps to some slot, the comparison rejects it
+      const Entry* entry = _slots + slot(hash);
+      return entry->first == key ? entry : end();
+    }
+
+    /**
+    * Visit every entry
+    * @param visit a function taking an entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+      for (size_t i = 0; i < _hashTableSize; ++i) visit(_slots[i]);
+    }
+
+    /**
+    * Visit every entry
+    * @param visit a function taking a constant entry reference
+    */
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+      for (size_t i = 0; i < _hashTableSize; ++i) visit(static_cast<const Entry&>(_slots[i]));
+    }
+
+    /**
+    * Remove all entries
+    */
+    void clear() {
+      for (size_t i = 0; _slots && i < _hashTableSize; ++i) _slots[i].~Entry();
+      ::operator delete(_slots);
+
+      _slots = nullptr;
+      _hashTableSize = 0;
+      _displacements = Vector<uint32_t>();
+      _multipliers = Vector<uint8_t>();
+    }
+
+    /**
+    * @return a constant iterator positioned above the last entry
+    */
+    const_iterator end() const
+    {
+      return _slots + _hashTableSize;
+    }
+
+  private:
+
+    /**
+    * @return the slot of a key hash
+    */
+    size_t slot(uint64_t hash) const {
+      size_t bucket = static_cast<size_t>(reduceRange(mixBits(hash ^ _seed), _displacements.size()));
+      return position(hash, _multipliers[bucket], _displacements[bucket]);
+    }
+
+    /**
+    * @return the slot of a key hash for a displacement (d0, d1)
+    */
+    size_t position(uint64_t hash, uint64_t d0, uint64_t d1) const {
+      return static_cast<size_t>((f1(hash) + d0 * f2(hash) + d1) % _hashTableSize);
+    }
+
+    /**
+    * Slot offsets of a key hash, in [0, n)
+    */
+    uint64_t f1(uint64_t hash) const { return reduceRange(mixBits(hash ^ (_seed + 0x9E3779B97F4A7C15ULL)), _hashTableSize); }
+    uint64_t f2(uint64_t hash) const { return reduceRange(mixBits(hash ^ (_seed + 0x3C6EF372FE94F82AULL)), _hashTableSize); }
+
+    /**
+    * Search a seed and displacements separating all hashes
+    * @return false if no seed succeeded
+    */
+    bool buildDisplacements(const Vector<uint64_t>& hashes) {
+      if (hashes.size() == 0) return true;
+      if (hashes.size() > std::numeric_limits<uint32_t>::max()) return false;
+
+      _hashTableSize = hashes.size();
+
+      for (size_t attempt = 0; attempt < MAX_SEED_ATTEMPTS; ++attempt) {
+        _seed = mixBits(attempt + 1);
+        if (placeBuckets(hashes)) return true;
+      }
+
+      _hashTableSize = 0;
+      return false;
+    }
+
+    /**
+    * Place all buckets with the current seed
+    * @return false if some bucket could not be placed
+    */
+    bool placeBuckets(const Vector<uint64_t>& hashes) {
+      size_t keyCount = hashes.size();
+      size_t bucketCount = keyCount / AVERAGE_BUCKET_SIZE + 1;
+
+      _displacements.resize(bucketCount);
+      _multipliers.resize(bucketCount);
+
+      // Group keys by bucket with a counting sort
+      Vector<uint32_t> bucketStart;
+      bucketStart.resize(bucketCount + 1);
+      for (auto& start : bucketStart) start = 0;
+
+      Vector<uint32_t> keyBucket;
+      keyBucket.resize(keyCount);
+      for (size_t i = 0; i < keyCount; ++i) {
+        keyBucket[i] = static_cast<uint32_t>(reduceRange(mixBits(hashes[i] ^ _seed), bucketCount));
+        ++bucketStart[keyBucket[i] + 1];
+      }
+
+      size_t maxBucketSize = 0;
+      for (size_t b = 0; b < bucketCount; ++b) {
+        if (bucketStart[b + 1] > maxBucketSize) maxBucketSize = bucketStart[b + 1];
+        bucketStart[b + 1] += bucketStart[b];
+      }
+
+      Vector<uint32_t> bucketKeys;
+      bucketKeys.resize(keyCount);
+      {
+        Vector<uint32_t> next = bucketStart;
+        for (size_t i = 0; i < keyCount; ++i) bucketKeys[next[keyBucket[i]]++] = static_cast<uint32_t>(i);
+      }
+
+      // Order buckets from the largest with a counting sort on their sizes
+      Vector<uint32_t> sizeStart;
+      sizeStart.resize(maxBucketSize + 2);
+      for (auto& start : sizeStart) start = 0;
+      for (size_t b = 0; b < bucketCount; ++b) ++sizeStart[maxBucketSize - (bucketStart[b + 1] - bucketStart[b]) + 1];
+      for (size_t s = 0; s <= maxBucketSize; ++s) sizeStart[s + 1] += sizeStart[s];
+
+      Vector<uint32_t> buckets;
+      buckets.resize(bucketCount);
+      for (size_t b = 0; b < bucketCount; ++b) {
+        buckets[sizeStart[maxBucketSize - (bucketStart[b + 1] - bucketStart[b])]++] = static_cast<uint32_t>(b);
+      }
+
+      // One bit per taken slot
+      Vector<uint64_t> taken;
+      taken.resize(keyCount / 64 + 1);
+      for (auto& word : taken) word = 0;
+
+      size_t freeSlot = 0;
+      Vector<uint64_t, 32> offsets;
+      Vector<uint64_t, 32> strides;
+      Vector<size_t, 32> slots;
+
+      for (auto bucket : buckets) {
+        size_t bucketSize = bucketStart[bucket + 1] - bucketStart[bucket];
+        const uint32_t* keys = bucketKeys.data() + bucketStart[bucket];
+
+        if (bucketSize == 0) {
+          _multipliers[bucket] = 0;
+          _displacements[bucket] = 0;
+
+        } else if (bucketSize == 1) {
+          // Land the single key directly in the next free slot
+          while (taken[freeSlot / 64] & (1ULL << (freeSlot % 64))) ++freeSlot;
+
+          _multipliers[bucket] = 0;
+          _displacements[bucket] = static_cast<uint32_t>((freeSlot + keyCount - f1(hashes[keys[0]])) % keyCount);
+          taken[freeSlot / 64] |= 1ULL << (freeSlot % 64);
+
+        } else {
+          offsets.resize(bucketSize);
+          strides.resize(bucketSize);
+          slots.resize(bucketSize);
+
+          for (size_t k = 0; k < bucketSize; ++k) {
+            offsets[k] = f1(hashes[keys[k]]);
+            strides[k] = f2(hashes[keys[k]]);
+
+            // Keys with the same offsets are never separated by a displacement
+            for (size_t j = 0; j < k; ++j) {
+              if (offsets[j] == offsets[k] && strides[j] == strides[k]) return false;
+            }
+          }
+
+          if (!placeBucket(bucket, offsets, strides, slots, taken)) return false;
+        }
+      }
+
+      return true;
+    }
+
+    /**
+    * Search the first displacement landing all keys of a bucket in distinct free slots
+    * @return false if no displacement succeeded
+    */
+    bool placeBucket(size_t bucket,
+                     const Vector<uint64_t, 32>& offsets,
+                     const Vector<uint64_t, 32>& strides,
+                     Vector<size_t, 32>& slots,
+                     Vector<uint64_t>& taken) {
+      size_t bucketSize = offsets.size();
+
+      for (uint64_t d0 = 0; d0 <= std::numeric_limits<uint8_t>::max(); ++d0) {
+        for (uint64_t d1 = 0; d1 < _hashTableSize; ++d1) {
+
+          size_t k = 0;
+          for (; k < bucketSize; ++k) {
+            size_t candidate = static_cast<size_t>((offsets[k] + d0 * strides[k] + d1) % _hashTableSize);
+            if (taken[candidate / 64] & (1ULL << (candidate % 64))) break;
+
+            size_t j = 0;
+            for (; j < k && slots[j] != candidate; ++j);
+            if (j < k) break;
+
+            slots[k] = candidate;
+          }
+
+          if (k < bucketSize) continue;
+
+          for (auto candidate : slots) taken[candidate / 64] |= 1ULL << (candidate % 64);
+
+          _multipliers[bucket] = static_cast<uint8_t>(d0);
+          _displacements[bucket] = static_cast<uint32_t>(d1);
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /// Inline entries, one per slot
+    Entry* _slots;
+
+    size_t _hashTableSize;
+
+    /// Seed of the bucket and slot hashes
+    uint64_t _seed;
+
+    /// Displacements d1 and multipliers d0, per bucket
+    Vector<uint32_t> _displacements;
+    Vector<uint8_t>  _multipliers;
+  };
+
+} // end namespace Concept
+
+#endif
@@ -34,35 +34,82 @@
 
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <type_traits>
+#include "View.hpp"
 
 namespace Concept {
 
-  /// Reuse pointer size as small string storage
-  const size_t DEFAULT_SMALL_STRING_MAX_LENGTH = sizeof(void*);
+  /// Small strings fill the object but its last byte: 23 characters on 64-bit platforms
+  const size_t DEFAULT_SMALL_STRING_MAX_LENGTH = 3 * sizeof(void*) - 1;
   /**
   * String implementation with configurable string optimization
   * indeed, the Standard Library does not enforce such an optimization.
   * This means a string might be allocated in the head every time,
   * which is suboptimal.
   * Furthermore, it might be suitable to configure the maximum "small string" length later.
+  * Heap buffers come from std::allocator<char>, so that Vectors of characters can take them over.
+  *
+  * Small strings share their storage with the heap buffer pointer, length and capacity.
+  * The last byte holds the remaining small space, which becomes the terminating \0 of a full small string,
+  * or a flag in the capacity when the string is heap-allocated.
+  * SmallStringLength is thus rounded up to fill the object: String<> is 24 bytes on 64-bit platforms.
+  * The remaining small space and the flag share that byte, so that small strings hold at most
+  * MAX_SMALL_SIZE - 1 characters: a larger SmallStringLength is clamped, and longer strings go to the heap.
   */
   template <size_t SmallStringLength = DEFAULT_SMALL_STRING_MAX_LENGTH>
   class String {
 
+    /// Heap-allocated buffer
+    struct Heap {
+      char*  data;
+      size_t length;
+      size_t capacity;
+    };
+
+    /// Largest small buffer whose remaining space fits the last byte along with the flag bit
+    static constexpr size_t MAX_SMALL_SIZE = 128;
+
+    /// Size of the small buffer, including its last byte
+    static constexpr size_t SMALL_SIZE = (SmallStringLength + 1 > MAX_SMALL_SIZE ? MAX_SMALL_SIZE :
+                                          SmallStringLength + 1 > sizeof(Heap) ?
+                                          (SmallStringLength + alignof(Heap)) / alignof(Heap) * alignof(Heap) :
+                                          sizeof(Heap));
+
+    static_assert(SMALL_SIZE <= MAX_SMALL_SIZE, "The last byte holds the remaining small space along with a flag bit");
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    /// The last byte of the object is the least significant one of the capacity
+    static constexpr unsigned char HEAP_FLAG = 0x01;
+
+    static size_t encodeCapacity(size_t capacity) { return capacity << 1 | 1; }
+    static size_t decodeCapacity(size_t capacity) { return capacity >> 1; }
+    static char encodeRemaining(size_t remaining) { return static_cast<char>(remaining << 1); }
+    static size_t decodeRemaining(unsigned char remaining) { return remaining >> 1; }
+#else
+    /// The last byte of the object is the most significant one of the capacity
+    static constexpr unsigned char HEAP_FLAG = 0x80;
+
+    static size_t encodeCapacity(size_t capacity) { return capacity | ~(~size_t(0) >> 1); }
+    static size_t decodeCapacity(size_t capacity) { return capacity & (~size_t(0) >> 1); }
+    static char encodeRemaining(size_t remaining) { return static_cast<char>(remaining); }
+    static size_t decodeRemaining(unsigned char remaining) { return remaining; }
+#endif
+
   public:
 
     /**
     * Default constructor
     */
-    String() : _bufferSize(sizeof(_buffers.small)), _stringLength(0) {
-      _buffers.small[0] = 0;
+    String() {
+      reset();
     }
 
     /**
     * Copy constructor
     */
-    String(const String& other) : _bufferSize(sizeof(_buffers.small)), _stringLength(0) {
+    String(const String& other) {
+      reset();
       assign(other.c_str(), other.length());
     }
 
@@ -71,19 +118,14 @@ namespace Concept {
     */
     String(String&& other) {
 
-      if (other._bufferSize > SmallStringLength + 1 &&
-          _bufferSize > SmallStringLength + 1) {
+      if (other.onHeap()) {
         // Transfer the heap-allocated buffer
-        _buffers.large = other._buffers.large;
-        _bufferSize    = other._bufferSize;
-        _stringLength  = other._stringLength;
+        _buffers = other._buffers;
 
-        other._bufferSize = SmallStringLength + 1;
-        other._stringLength = 0;
+        other.reset();
       }
       else {
-        _bufferSize = SmallStringLength + 1;
-        _stringLength = 0;
+        reset();
         assign(other.data(), other.length());
       }
     }
@@ -92,16 +134,16 @@ namespace Concept {
     * Constructor from null-terminated strings
     */
     String(const char* cstr) {
-      _stringLength = strlen(cstr);
-      _bufferSize = (_stringLength <= SmallStringLength ?
-                     sizeof(_buffers.small) : _stringLength + 1);
-
-      // pBuffer points to either the small buffer
-      // or the larger one for larger null-terminated strings
-      char* pBuffer = (_stringLength <= SmallStringLength ?
-                        _buffers.small : _buffers.large = new char[_bufferSize]);
+      reset();
+      assign(cstr, strlen(cstr));
+    }
 
-      memcpy(pBuffer, cstr, _stringLength + 1);
+    /**
+    * Constructor from a character view
+    */
+    String(const View<char>& view) {
+      reset();
+      assign(view.data(), view.size());
     }
 
     /**
@@ -109,7 +151,7 @@ namespace Concept {
     */
     ~String() {
       // If the buffer is heap-allocated, delete it
-       if (_bufferSize > SmallStringLength + 1) delete[] _buffers.large;
+      if (onHeap()) std::allocator<char>().deallocate(_buffers.heap.data, capacity() + 1);
     }
 
     /**
@@ -125,22 +167,25 @@ namespace Concept {
     void reserve(size_t stringLength) {
 
       // Enough space, return
-      if (_bufferSize > stringLength) return;
+      if (capacity() >= stringLength) return;
 
       // Allocate a new buffer
       size_t newBufferSize = stringLength + 1;
-      char* pNewBuffer = new char[newBufferSize];
+      char* pNewBuffer = std::allocator<char>().allocate(newBufferSize);
 
       // Do nothing if the string length is zero
       // Otherwise, copy old content with the terminating \0
-      memcpy(pNewBuffer, data(), _stringLength + 1);
+      size_t len = length();
+      memcpy(pNewBuffer, data(), len + 1);
 
       // If the old buffer is heap-allocated, delete it
-      if (_bufferSize > SmallStringLength + 1) delete[] _buffers.large;
+      if (onHeap()) std::allocator<char>().deallocate(_buffers.heap.data, capacity() + 1);
 
       // Replace the heap-allocated buffer
-      _buffers.large = pNewBuffer;
-      _bufferSize = newBufferSize;
+      _buffers.heap.data = pNewBuffer;
+      _buffers.heap.length = len;
+      _buffers.heap.capacity = encodeCapacity(stringLength);
+      markHeap();
     }
 
 
@@ -149,7 +194,7 @@ namespace Concept {
     */
     template <size_t N>
     bool operator<(const String<N>& other) const {
-      return strncmp(c_str(), other.c_str(), _stringLength + 1) < 0;
+      return strncmp(c_str(), other.c_str(), length() + 1) < 0;
     }
 
 
@@ -157,7 +202,7 @@ namespace Concept {
     * Check  equality with null-terminated string
     */
     bool operator==(const char* cstr) const {
-      return strncmp(c_str(), cstr, _stringLength + 1) == 0;
+      return strncmp(c_str(), cstr, length() + 1) == 0;
     }
 
     /**
@@ -172,7 +217,7 @@ namespace Concept {
     */
     template <size_t N>
     bool operator==(const String<N>& other) const {
-      return strncmp(c_str(), other.c_str(), _stringLength + 1) == 0;
+      return strncmp(c_str(), other.c_str(), length() + 1) == 0;
     }
 
     /**
@@ -232,9 +277,9 @@ namespace Concept {
       size_t cstrLen = strlen(cstr);
 
       String result;
-      result.reserve(_stringLength + cstrLen);
+      result.reserve(length() + cstrLen);
 
-      result.assign(data(), _stringLength);
+      result.assign(data(), length());
       result.append(cstr, cstrLen);
 
       return result;
@@ -247,9 +292,9 @@ namespace Concept {
     String operator+(const String<N>& other) const {
 
       String result;
-      result.reserve(_stringLength + other.length());
+      result.reserve(length() + other.length());
 
-      result.assign(c_str(), _stringLength);
+      result.assign(c_str(), length());
       result.append(other.c_str(), other.length());
 
       return result;
@@ -260,31 +305,64 @@ namespace Concept {
     * @return the character at pos or 0 if pos is out-of-range
     */
     char operator[](size_t pos) const {
-      if (pos >= _stringLength) return 0;
-      return data()[pos];
+      if (pos >= length()) return 0;
+      return c_str()[pos];
     }
 
     /**
     * @return String length
     */
     size_t length() const {
-      return _stringLength;
+      if (onHeap()) return _buffers.heap.length;
+
+      return SMALL_SIZE - 1 - decodeRemaining(static_cast<unsigned char>(_buffers.small[SMALL_SIZE - 1]));
     }
 
     /**
-    * @return the ma
+    * @return the maximum length without reallocation
     */
     size_t capacity() const {
-      return _bufferSize - 1;
+      return (onHeap() ? decodeCapacity(_buffers.heap.capacity) : SMALL_SIZE - 1);
     }
 
   private:
 
+    /**
+    * @return whether the buffer is heap-allocated
+    */
+    bool onHeap() const {
+      return (static_cast<unsigned char>(_buffers.small[SMALL_SIZE - 1]) & HEAP_FLAG) != 0;
+    }
+
+    /**
+    * Flag the heap-allocated buffer in the last byte.
+    * It is already set by the capacity when the latter ends the object
+    */
+    void markHeap() {
+      _buffers.small[SMALL_SIZE - 1] |= HEAP_FLAG;
+    }
+
+    /**
+    * Become an empty small string, forgetting the previous storage
+    */
+    void reset() {
+      _buffers.small[0] = 0;
+      _buffers.small[SMALL_SIZE - 1] = encodeRemaining(SMALL_SIZE - 1);
+    }
+
+    /**
+    * Keep track of the string length, its terminating \0 excepted
+    */
+    void setLength(size_t len) {
+      if (onHeap()) _buffers.heap.length = len;
+      else _buffers.small[SMALL_SIZE - 1] = encodeRemaining(SMALL_SIZE - 1 - len);
+    }
+
     /**
     * @return the internal buffer
     */
     char* data() {
-      return (_bufferSize <= SmallStringLength + 1 ? _buffers.small : _buffers.large);
+      return (onHeap() ? _buffers.heap.data : _buffers.small);
     }
 
     /**
@@ -292,18 +370,19 @@ namespace Concept {
     */
     void assign(const char* cstr, size_t len) {
 
-      if (len >= _bufferSize) {
+      if (len > capacity()) {
         // Reset the string
-        _stringLength = 0;
+        setLength(0);
+        data()[0] = 0;
 
         // Allocate more space
         reserve(len);
       }
 
       // Copy the new string
-      memcpy(data(), cstr, len);
+      memmove(data(), cstr, len);
 
-      _stringLength = len;
+      setLength(len);
       // Terminate the string with a null character
       data()[len] = 0;
     }
@@ -312,32 +391,30 @@ namespace Concept {
     * Append a C-string
     */
     void append(const char* cstr, size_t len) {
-      reserve(_stringLength + len);
-      memcpy(data() + _stringLength, cstr, len);
+      size_t oldLength = length();
 
-      _stringLength += len;
-      data()[_stringLength] = 0;
+      reserve(oldLength + len);
+      memcpy(data() + oldLength, cstr, len);
+
+      setLength(oldLength + len);
+      data()[oldLength + len] = 0;
     }
 
-    /// Reuse the pointer stack storage for small strings
+    /// Reuse the heap buffer storage for small strings
     union {
-      char* large;
-      char  small[SmallStringLength + 1];
+      Heap heap;
+      char small[SMALL_SIZE];
     } _buffers;
 
-    /// Keep track of internal buffer size
-    size_t _bufferSize;
-
-    /// Keep track of the actual string length
-    size_t _stringLength;
-
     // Make all Strings friends for accessing private members
     template <size_t N>
     friend class String;
 
     // Make all Vectors friends for accessing private members
     template <typename T,
-              size_t N>
+              size_t N,
+              typename Allocator,
+              typename SizeType>
     friend class Vector;
   };
 
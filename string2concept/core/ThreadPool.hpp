@@ -0,0 +1,189 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_THREADPOOL_HPP
+#define CONCEPT_THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concept {
+
+  /// Number of task blocks handed out per thread, balancing uneven tasks against scheduling costs
+  const size_t DEFAULT_THREADPOOL_BLOCKS_PER_THREAD = 8;
+
+  /**
+  * Fixed pool of worker threads running indexed tasks.
+  * Workers are started once and sleep between runs. The calling thread takes part
+  * in every run, so a pool of n threads starts n - 1 workers.
+  * Tasks are claimed by blocks of consecutive indices from a shared counter:
+  * threads finishing early take more blocks, and no queue is allocated per task.
+  */
+  class ThreadPool {
+
+  public:
+
+    /**
+    * Constructor
+    * @param threadCount the number of threads running tasks, including the caller.
+    *  Zero means one per hardware thread
+    */
+    explicit ThreadPool(size_t threadCount = 0)
+      : _taskCount(0), _blockSize(1), _nextTask(0), _busyWorkers(0), _generation(0), _stopping(false) {
+
+      if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+      if (threadCount == 0) threadCount = 1;
+
+      // std::thread is move-only, hence std::vector
+      _workers.reserve(threadCount - 1);
+      for (size_t i = 1; i < threadCount; ++i) _workers.push_back(std::thread(&ThreadPool::work, this));
+    }
+
+    /**
+    * A pool owns its threads
+    */
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+    * Destructor: stop and join the workers
+    */
+    ~ThreadPool() {
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+      }
+
+      _wakeUp.notify_all();
+      for (auto& worker : _workers) worker.join();
+    }
+
+    /**
+    * @return the number of threads running tasks, including the caller
+    */
+    size_t size() const {
+      return _workers.size() + 1;
+    }
+
+    /**
+    * Run task(i) for every i in [0, taskCount), then return.
+    * Tasks run concurrently and in no particular order. They must not throw.
+    * Concurrent runs on the same pool are serialized.
+    * @param taskCount the number of tasks
+    * @param task a function taking the task index
+    */
+    template <typename Function>
+    void run(size_t taskCount, Function task) {
+      if (taskCount == 0) return;
+
+      std::lock_guard<std::mutex> runLock(_runMutex);
+
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task        = task;
+        _taskCount   = taskCount;
+        _blockSize   = std::max<size_t>(1, taskCount / (size() * DEFAULT_THREADPOOL_BLOCKS_PER_THREAD));
+        _nextTask    = 0;
+        _busyWorkers = _workers.size();
+        ++_generation;
+      }
+
+      _wakeUp.notify_all();
+      execute();
+
+      std::unique_lock<std::mutex> lock(_mutex);
+      _done.wait(lock, [this]() { return _busyWorkers == 0; });
+      _task = nullptr;
+    }
+
+  private:
+
+    /**
+    * Worker loop: wait for a run, take part in it, then report
+    */
+    void work() {
+      size_t generation = 0;
+
+      for (;;) {
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _wakeUp.wait(lock, [this, generation]() { return _stopping || _generation != generation; });
+          if (_stopping) return;
+
+          generation = _generation;
+        }
+
+        execute();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_busyWorkers == 0) _done.notify_one();
+      }
+    }
+
+    /**
+    * Claim and run blocks of tasks until none is left
+    */
+    void execute() {
+      for (;;) {
+        size_t first = _nextTask.fetch_add(_blockSize);
+        if (first >= _taskCount) return;
+
+        size_t last = std::min(first + _blockSize, _taskCount);
+        for (size_t i = first; i < last; ++i) _task(i);
+      }
+    }
+
+    std::vector<std::thread> _workers;
+
+    /// The current run, published under _mutex before the workers wake up
+    std::function<void(size_t)> _task;
+    size_t                      _taskCount;
+    size_t                      _blockSize;
+    std::atomic<size_t>         _nextTask;
+
+    size_t _busyWorkers;
+    size_t _generation;
+    bool   _stopping;
+
+    std::mutex              _mutex;
+    std::mutex              _runMutex;
+    std::condition_variable _wakeUp;
+    std::condition_variable _done;
+  };
+
+} // end namespace Concept
+
+#endif
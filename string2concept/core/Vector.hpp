@@ -1,7 +1,7 @@
 /**
-* @file
-* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
-*
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
 * @section LICENSE
 *
 * The MIT License
@@ -32,11 +32,16 @@
 #ifndef CONCEPT_VECTOR_HPP
 #define CONCEPT_VECTOR_HPP
 
-#include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include "Elements.hpp"
 #include "String.hpp"
+#include "View.hpp"
 
 namespace Concept {
 
@@ -44,10 +49,31 @@ namespace Concept {
   const size_t DEFAULT_SMALL_VECTOR_MAX_SIZE = 8;
   /**
   * Vector implementation with configurable small vector optimization
+  *
+  * Storage is uninitialized: elements are constructed in place when added, and destroyed when removed.
+  * Heap buffers come from the Allocator and grow geometrically, so appending costs amortized constant time;
+  * growing moves the elements, unless their move constructor may throw.
+  * reserve() still allocates the exact size requested.
+  *
+  * Trivially copyable elements of the standard allocator are copied and moved with memcpy and memmove,
+  * integers, enumerations and pointers are compared with memcmp, and bytes searched with memchr.
+  *
+  * The small buffer shares its storage with the heap buffer pointer, and the ownership flag takes the top bit
+  * of the capacity: a Vector<char> is 24 bytes. SizeType = uint32_t brings it to 16 bytes,
+  * for collections of many short vectors, which then hold less than 2^31 elements.
   */
-  template <typename T, size_t SmallVectorSize = DEFAULT_SMALL_VECTOR_MAX_SIZE>
+  template <typename T,
+            size_t SmallVectorSize = DEFAULT_SMALL_VECTOR_MAX_SIZE,
+            typename Allocator = std::allocator<T>,
+            typename SizeType = size_t>
   class Vector {
 
+    using AllocatorTraits = std::allocator_traits<Allocator>;
+
+    /// Whether elements are copied bitwise: constructing them with the standard allocator has no other effect
+    using IsMemcpyable = std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                                      std::is_same<Allocator, std::allocator<T> >::value>;
+
   public:
 
     // Defining an iterator
@@ -56,6 +82,9 @@ namespace Concept {
     // Defining an iterator over constant values
     using const_iterator = const T*;
 
+    using value_type     = T;
+    using allocator_type = Allocator;
+
   // The insertion policy
     enum Insertion {
       UNORDERED, /// The collection is assumed unordered. Cannot be used along with UNIQUE
@@ -66,33 +95,49 @@ namespace Concept {
     /**
     * Default constructor
     */
-    Vector() : _bufferOwned(true), _bufferSize(SmallVectorSize), _vectorSize(0) {}
+    Vector() : _capacity(SmallVectorSize), _vectorSize(0) {
+      _buffers.large = nullptr;
+    }
+
+    /**
+    * Constructor with an allocator
+    */
+    explicit Vector(const Allocator& allocator) :
+      _buffers(allocator), _capacity(SmallVectorSize), _vectorSize(0) {
+      _buffers.large = nullptr;
+    }
 
     /**
     * Construct the vector from an initialization list
     */
     Vector(std::initializer_list<T> initList) :
-      _bufferOwned(true), _bufferSize(SmallVectorSize), _vectorSize(0) {
+      _capacity(SmallVectorSize), _vectorSize(0) {
+      _buffers.large = nullptr;
 
-      for (auto& item : initList) push_back(item);
+      reserve(initList.size());
+      append(initList.begin(), initList.size());
     }
 
     /**
     * Copy constructor.
     * Share buffer if not owned, otherwise copy it
     */
-    Vector(const Vector& other) {
+    Vector(const Vector& other) :
+      _buffers(AllocatorTraits::select_on_container_copy_construction(other.allocator())),
+      _capacity(SmallVectorSize), _vectorSize(0) {
 
-      if (other._bufferOwned) {
+      if (other.owned()) {
         // Copy buffer
-        _bufferOwned   = true;
-        _bufferSize = SmallVectorSize;
+        setOwned(true);
+        setBufferSize(SmallVectorSize);
         _vectorSize = 0;
-        assign(other.data(), other._vectorSize);
+        _buffers.large = nullptr;
+        reserve(other._vectorSize);
+        append(other.data(), other._vectorSize);
       } else {
         // Overlay the same buffer
-        _bufferOwned = false;
-        _bufferSize = other._bufferSize;
+        setOwned(false);
+        setBufferSize(other.bufferSize());
         _vectorSize = other._vectorSize;
         _buffers.large = other._buffers.large;
       }
@@ -100,27 +145,29 @@ namespace Concept {
 
     /**
     * Move constructor.
-    *  Transfer buffer if heap-allocated or not owned. Otherwise copy it
+    *  Transfer buffer if heap-allocated or not owned. Otherwise move its elements
     */
-    Vector(Vector&& other) {
+    Vector(Vector&& other) :
+      _buffers(std::move(other.allocator())), _capacity(SmallVectorSize), _vectorSize(0) {
 
-      if (!other._bufferOwned || other._bufferSize > SmallVectorSize) {
-        // Transfer the heap-allocated buffer
-        _bufferOwned   = false;
-        _bufferSize    = other._bufferSize;
+      if (!other.owned() || other.bufferSize() > SmallVectorSize) {
+        // Transfer the heap-allocated buffer along with its ownership
+        setOwned(other.owned());
+        setBufferSize(other.bufferSize());
         _vectorSize    = other._vectorSize;
         _buffers.large = other._buffers.large;
 
         // Reset the other 
-        other._bufferOwned = true;
-        other._bufferSize  = SmallVectorSize;
+        other.setOwned(true);
+        other.setBufferSize(SmallVectorSize);
         other._vectorSize  = 0;
       } else {
-        // Copy buffer
-        _bufferOwned = true;
-        _bufferSize = SmallVectorSize;
+        // Move the elements of the small buffer
+        setOwned(true);
+        setBufferSize(SmallVectorSize);
         _vectorSize = 0;
-        assign(other.data(), other._vectorSize);
+        _buffers.large = nullptr;
+        moveFrom(other);
       }
     }
 
@@ -130,23 +177,19 @@ namespace Concept {
     * @param len the buffer len
     * @param copy if false, the vector does not own the buffer. It acts as  a not owned overlay.
     */
-    Vector(const T* buffer, size_t len, bool copy = true) {
-      _bufferOwned = copy;
-      _vectorSize = len;
+    Vector(const T* buffer, size_t len, bool copy = true) : _capacity(SmallVectorSize), _vectorSize(0) {
+      setOwned(copy);
 
       if (copy) {
-        _bufferSize = (len <= SmallVectorSize ? SmallVectorSize : len);
-
-        // pBuffer points to either the small internal buffer
-        // or the larger one for larger inputs
-        T* pBuffer = (_vectorSize <= SmallVectorSize ?
-                          _buffers.small : _buffers.large = new T[_bufferSize]);
-
-        copyObjects(pBuffer, buffer, len);
-
+        setBufferSize(SmallVectorSize);
+        _vectorSize = 0;
+        _buffers.large = nullptr;
+        reserve(len);
+        append(buffer, len);
       } else {
         // buffer is not owned
-        _bufferSize = len;
+        _vectorSize = len;
+        setBufferSize(len);
         _buffers.large = const_cast<T*>(buffer);
       }
     }
@@ -157,51 +200,51 @@ namespace Concept {
     */
     template <size_t N,
               typename CHAR_ONLY = std::enable_if<std::is_same<T, char>::value, void> >
-    Vector(const String<N>& str, bool copy = true) {
+    Vector(const String<N>& str, bool copy = true) : _capacity(SmallVectorSize), _vectorSize(0) {
 
-      _bufferOwned = copy;
-      _vectorSize = str.length();
+      setOwned(copy);
 
       if (copy) {
         // Buffer copy mode
-        _bufferSize = (str.length() < SmallVectorSize ? SmallVectorSize : _vectorSize);
-
-        // pBuffer points to either the small internal buffer
-        // or the larger one for larger inputs
-        char* pBuffer = (_vectorSize <= SmallVectorSize ?
-          _buffers.small : _buffers.large = new char[_bufferSize]);
-
-        copyObjects(pBuffer, str.c_str(), _vectorSize);
+        setBufferSize(SmallVectorSize);
+        _vectorSize = 0;
+        _buffers.large = nullptr;
+        reserve(str.length());
+        append(str.c_str(), str.length());
       }
       else {
         // Overlay mode
-        _bufferSize = str.capacity() + 1;
+        _vectorSize = str.length();
+        setBufferSize(str.capacity() + 1);
         _buffers.large = const_cast<char*>(str.c_str());
       }
     }
 
     /**
     * SFINAE-reserved constructor for Vectors of characters:
-    * Construct from a string rvalue reference
+    * Construct from a string rvalue reference.
+    * Strings allocate from std::allocator<char>: their heap buffer is transferred to Vectors that do too
     */
     template <size_t N,
               typename CHAR_ONLY = std::enable_if<std::is_same<T, char>::value, void> >
-    Vector(String<N>&& str) {
-      _bufferOwned = true;
+    Vector(String<N>&& str) : _capacity(SmallVectorSize), _vectorSize(0) {
+      setOwned(true);
 
-      if (str.capacity() > N + 1) {
+      if (str.onHeap() && str.capacity() + 1 > SmallVectorSize &&
+          std::is_same<Allocator, std::allocator<char> >::value) {
         // Transfer the heap-allocated buffer
         _buffers.large = const_cast<char*>(str.c_str());
-        _bufferSize = str.capacity() + 1;
+        setBufferSize(str.capacity() + 1);
         _vectorSize = str.length();
 
-        str._bufferSize = N + 1;
-        str._stringLength = 0;
+        str.reset();
       }
       else {
-        _bufferSize = SmallVectorSize;
+        setBufferSize(SmallVectorSize);
         _vectorSize = 0;
-        assign(str.c_str(), str.length());
+        _buffers.large = nullptr;
+        reserve(str.length());
+        append(str.c_str(), str.length());
       }
     }
 
@@ -209,63 +252,57 @@ namespace Concept {
     * Destructor
     */
     ~Vector() {
-      // If the buffer is heap-allocated and owned, delete it
-     if (_bufferOwned && _bufferSize > SmallVectorSize) delete[] _buffers.large;
+      release();
     }
 
     /**
-    * Extend the internal buffer if smaller.
+    * Extend the internal buffer to exactly vectorSize elements if smaller.
     * This function has no effect if the vector is not owned
     */
     void reserve(size_t vectorSize) {
 
       // Enough space, return
-      if (!_bufferOwned || _bufferSize >= vectorSize) return;
-
-      // Allocate a new buffer
-      size_t newBufferSize = vectorSize;
-      T* pNewBuffer = new T[newBufferSize];
+      if (!owned() || bufferSize() >= vectorSize) return;
+      if (vectorSize > max_size()) throw std::length_error("Vector size exceeds SizeType");
 
-      // Do nothing if the vector size is zero
-      // Otherwise, copy old content
-      copyObjects(pNewBuffer, data(), _vectorSize);
+      // Move the elements to a new buffer
+      T* pNewBuffer = AllocatorTraits::allocate(allocator(), vectorSize);
+      relocate(pNewBuffer, data(), _vectorSize);
 
-      // If the old buffer is heap-allocated, delete it
-      if (_bufferSize > SmallVectorSize) delete[] _buffers.large;
+      // If the old buffer is heap-allocated, deallocate it
+      if (bufferSize() > SmallVectorSize) AllocatorTraits::deallocate(allocator(), _buffers.large, bufferSize());
 
       // Replace the heap-allocated buffer
       _buffers.large = pNewBuffer;
-      _bufferSize = newBufferSize;
+      setBufferSize(vectorSize);
     }
 
     /**
     * Copy-assignment of another Vector.
-    * Share buffer if not owned, Otherwise copy it
+    * Share buffer if not owned, Otherwise copy it into the current buffer
     */
     Vector& operator=(const Vector& other) {
 
-      // Reset self
-      if (!_bufferOwned) {
-        _bufferOwned = true;
-      }
-      else if (_bufferSize > SmallVectorSize) {
-        // self owns a heap-allocated buffer, free it
-        delete[] _buffers.large;
-      }
+      if (this == &other) return *this;
 
-      _bufferSize = SmallVectorSize;
-      _vectorSize = 0;
+      if (other.owned()) {
+        // Copy other's elements, keeping the buffer if owned
+        if (owned()) {
+          destroy(data(), _vectorSize);
+          _vectorSize = 0;
+        } else {
+          reset();
+        }
 
-      // Transfer
-      if (other._bufferOwned) {
-        // Copy other's buffer
-        _bufferOwned = true;
-        assign(other.data(), other.size());
+        reserve(other.size());
+        append(other.data(), other.size());
       } else {
         // Share a the heap-allocated buffer
-        _bufferOwned = false;
+        release();
+
+        setOwned(false);
         _buffers.large = other._buffers.large;
-        _bufferSize = other._bufferSize;
+        setBufferSize(other.bufferSize());
         _vectorSize = other._vectorSize;
       }
 
@@ -274,39 +311,36 @@ namespace Concept {
 
     /**
     * Move assignment of another Vector.
-    * Move buffer if heap-allocated or not owned, Otherwise copy it
+    * Move buffer if heap-allocated or not owned, Otherwise move its elements
     */
     Vector& operator=(Vector&& other) {
 
+      if (this == &other) return *this;
+
       // Reset self
-      if (!_bufferOwned) {
-        _bufferOwned = false;
-      }
-      else if (_bufferSize > SmallVectorSize) {
-        // self owns a heap-allocated buffer, free it
-        delete[] _buffers.large;
-      }
+      release();
 
-      _bufferSize = SmallVectorSize;
-      _vectorSize = 0;
+      bool transferable = AllocatorTraits::propagate_on_container_move_assignment::value ||
+                          allocator() == other.allocator();
 
       // Transfer
-      if (!other._bufferOwned || other._bufferSize > SmallVectorSize) {
+      if (!other.owned() || (other.bufferSize() > SmallVectorSize && transferable)) {
         // Move the heap-allocated or external buffer
-        _bufferOwned   = other._bufferOwned;
+        if (AllocatorTraits::propagate_on_container_move_assignment::value) allocator() = std::move(other.allocator());
+
+        setOwned(other.owned());
         _buffers.large = other._buffers.large;
-        _bufferSize    = other._bufferSize;
+        setBufferSize(other.bufferSize());
         _vectorSize    = other._vectorSize;
 
         // Reset other
-        other._bufferOwned = true;
-        other._bufferSize = SmallVectorSize;
+        other.setOwned(true);
+        other.setBufferSize(SmallVectorSize);
         other._vectorSize = 0;
       }
       else {
-        // Copy other's buffer
-        _bufferOwned = true;
-        assign(other.data(), other.size());
+        // Move other's elements
+        moveFrom(other);
       }
 
       return *this;
@@ -317,7 +351,7 @@ namespace Concept {
     * This function has no effect if the vector is not owned
     */
     Vector& operator+=(const T& value) {
-      if (_bufferOwned) append(&value, 1);
+      if (owned()) emplace_back(value);
 
       return *this;
     }
@@ -326,9 +360,9 @@ namespace Concept {
     * Append another Vector.
     * This function has no effect if the vector is not owned
     */
-    template <size_t N>
-    Vector& operator+=(const Vector<T, N>& other) {
-      if (_bufferOwned) append(other.data(), other.size());
+    template <size_t N, typename A, typename S>
+    Vector& operator+=(const Vector<T, N, A, S>& other) {
+      if (owned()) append(other.data(), other.size());
 
       return *this;
     }
@@ -336,13 +370,23 @@ namespace Concept {
     /**
     * Equality check
     */
-    template <size_t N>
-    bool operator==(const Vector<T, N>& other) const {
+    template <size_t N, typename A, typename S>
+    bool operator==(const Vector<T, N, A, S>& other) const {
 
       if (_vectorSize !=  other._vectorSize) return false;
 
-      return compare(data(), other.data(), _vectorSize);
+      return Elements::equal(data(), other.data(), _vectorSize);
+
+    }
+
+    /**
+    * Equality check with a view
+    */
+    bool operator==(const View<T>& other) const {
+
+      if (_vectorSize != other.size()) return false;
 
+      return Elements::equal(data(), other.data(), _vectorSize);
     }
 
     /**
@@ -350,9 +394,47 @@ namespace Concept {
     * This function has no effect if the vector is not owned
     */
     void push_back(const T& value) {
-      if (!_bufferOwned) return;
+      if (!owned()) return;
+
+      emplace_back(value);
+    }
+
+    /**
+    * Append a value by moving it.
+    * This function has no effect if the vector is not owned
+    */
+    void push_back(T&& value) {
+      if (!owned()) return;
+
+      emplace_back(std::move(value));
+    }
+
+    /**
+    * Construct a value in place at the end.
+    * The arguments may refer to elements of the vector, even when it grows.
+    * The vector must be owned
+    * @return the new element
+    */
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+
+      if (_vectorSize < bufferSize()) {
+        AllocatorTraits::construct(allocator(), data() + _vectorSize, std::forward<Args>(args)...);
+      } else {
+        // Construct the new element before moving the others, which args may refer to
+        size_t newBufferSize = grownSize(_vectorSize + 1);
+        T* pNewBuffer = AllocatorTraits::allocate(allocator(), newBufferSize);
+
+        AllocatorTraits::construct(allocator(), pNewBuffer + _vectorSize, std::forward<Args>(args)...);
+        relocate(pNewBuffer, data(), _vectorSize);
+
+        if (bufferSize() > SmallVectorSize) AllocatorTraits::deallocate(allocator(), _buffers.large, bufferSize());
+
+        _buffers.large = pNewBuffer;
+        setBufferSize(newBufferSize);
+      }
 
-      *this += value;
+      return data()[_vectorSize++];
     }
 
     /**
@@ -421,7 +503,7 @@ namespace Concept {
     */
     iterator insert(const T& value, int policy = Insertion::UNORDERED) {
 
-      if (!_bufferOwned) return end();
+      if (!owned()) return end();
 
       if (policy & Insertion::ORDERED) {
 
@@ -432,15 +514,22 @@ namespace Concept {
           if (*pos > value) break;
         }
 
-        resize(_vectorSize + 1);
+        // Growing may reallocate the buffer, keep the position as an offset, and value aside
+        size_t offset = pos - begin();
+        if (offset == _vectorSize) {
+          emplace_back(value);
+          return last();
+        }
+
+        T inserted(value);
+        emplace_back(std::move(*last()));
+        pos = begin() + offset;
 
         // Shift all items
-        for (auto it = last() ; it != pos; --it) {
-          *it = *(it - 1);
-        }
+        shift(pos, last() - 1 - pos);
 
         // Insert value at pos
-        *pos = value;
+        *pos = std::move(inserted);
         return pos;
 
       } else {
@@ -452,53 +541,83 @@ namespace Concept {
     /**
     * @return true if the vector contains that element
     * @param value The value to search
-    * @param comparator The comparisiom function. Set by default to the equality operator
     */
-    bool contains(const T& value,
-                  std::function<bool(const T&, const T&)> isEqual = [](const T& a, const T& b){ return a == b; }) const {
+    bool contains(const T& value) const {
+      return find(value) != end();
+    }
+
+    /**
+    * @return true if the vector contains that element
+    * @param value The value to search
+    * @param isEqual The comparison function, called as isEqual(element, value)
+    */
+    template <typename Predicate>
+    bool contains(const T& value, Predicate isEqual) const {
       return find(value, isEqual) != end();
     }
 
     /**
-    * Search linearly an element matching value
+    * Search linearly an element equal to value, with memchr for bytes
     * @param value The value to search
     * @return an iterator pointing to the found element or end()
     */
-    iterator find(const T& value,
-                        std::function<bool(const T&, const T&)> isEqual = [](const T& a, const T& b) { return a == b; }) {
+    iterator find(const T& value) {
+      return const_cast<iterator>(Elements::find(data(), _vectorSize, value));
+    }
 
-      for (auto it = begin(); it != end(); ++it) {
-          if (isEqual(*it, value)) return it;
-      }
+    /**
+    * Search linearly an element equal to value, with memchr for bytes
+    * @param value The value to search
+    * @return a const iterator pointing to the found element or end()
+    */
+    const_iterator find(const T& value) const {
+      return Elements::find(data(), _vectorSize, value);
+    }
 
-      return end();
+    /**
+    * Search linearly an element matching value
+    * @param value The value to search
+    * @param isEqual The comparison function, called as isEqual(element, value)
+    * @return an iterator pointing to the found element or end()
+    */
+    template <typename Predicate>
+    iterator find(const T& value, Predicate isEqual) {
+      return const_cast<iterator>(Elements::findIf(data(), _vectorSize, value, isEqual));
     }
 
     /**
     * Search linearly an element matching value
     * @param value The value to search
+    * @param isEqual The comparison function, called as isEqual(element, value)
     * @return a const iterator pointing to the found element or end()
     */
-    const_iterator find(const T& value,
-      std::function<bool(const T&, const T&)> isEqual = [](const T& a, const T& b) { return a == b; }) const {
-
-      for (auto it = begin(); it != end(); ++it) {
-        if (isEqual(*it, value)) return it;
-      }
-
-      return end();
+    template <typename Predicate>
+    const_iterator find(const T& value, Predicate isEqual) const {
+      return Elements::findIf(data(), _vectorSize, value, isEqual);
     }
 
     /**
-    * Resize the Vector.
+    * Resize the Vector, growing the storage geometrically.
+    * New elements are default-initialized: trivial ones are left as is.
     * @note the actual storage never reduces.
     * This function has no effect if the vector is not owned
     * and the length exceeds the buffer size
     */
     void resize(size_t len) {
-      if (!_bufferOwned && len > _bufferSize) return;
+      if (!owned()) {
+        if (len <= bufferSize()) _vectorSize = len;
+        return;
+      }
+
+      if (len < _vectorSize) {
+        destroy(data() + len, _vectorSize - len);
+      } else if (len > _vectorSize) {
+        if (len > bufferSize()) reserve(grownSize(len));
+        if (!std::is_trivial<T>::value) {
+          for (T* p = data() + _vectorSize; p != data() + len; ++p) AllocatorTraits::construct(allocator(), p);
+        }
+      }
 
-       reserve(len);
       _vectorSize = len;
     }
 
@@ -509,107 +628,232 @@ namespace Concept {
       return _vectorSize;
     }
 
+    /**
+    * @return the largest size SizeType can hold
+    */
+    static constexpr size_t max_size() {
+      return static_cast<size_t>(NOT_OWNED - 1);
+    }
+
     /**
     * @return the Vector capacity
     */
     size_t capacity() const {
-      return _bufferSize;
+      return bufferSize();
     }
 
     /**
     * @return the internal buffer
     */
     T* data() {
-      return (_bufferOwned && _bufferSize <= SmallVectorSize ? _buffers.small : _buffers.large);
+      return (owned() && bufferSize() <= SmallVectorSize ? small() : _buffers.large);
     }
 
     /**
     * @return the internal buffer
     */
     const T* data() const {
-      return (_bufferOwned && _bufferSize <= SmallVectorSize ? _buffers.small : _buffers.large);
+      return (owned() && bufferSize() <= SmallVectorSize ? small() : _buffers.large);
+    }
+
+    /**
+    * @return a copy of the allocator
+    */
+    Allocator get_allocator() const {
+      return allocator();
     }
 
   private:
 
+    /// Flag of not owned vectors, in the capacity
+    static constexpr SizeType NOT_OWNED = SizeType(1) << (8 * sizeof(SizeType) - 1);
+
+    Allocator& allocator() { return _buffers; }
+    const Allocator& allocator() const { return _buffers; }
+
     /**
-    * Assign a C-vector
+    * @return whether the vector operates on its own storage
     */
-    void assign(const T* buffer, size_t len) {
+    bool owned() const { return !(_capacity & NOT_OWNED); }
 
-      if (!_bufferOwned) return;
+    /**
+    * @return the internal buffer size
+    */
+    size_t bufferSize() const { return _capacity & ~NOT_OWNED; }
 
-      if (len > _bufferSize) {
+    void setOwned(bool owned) {
+      _capacity = (owned ? _capacity & ~NOT_OWNED : _capacity | NOT_OWNED);
+    }
 
-        // Reset the vector size
-        // to prevent reserve from copying old contents
-        _vectorSize = 0;
+    /**
+    * Keep the ownership flag
+    * @throw std::length_error if the size does not fit SizeType
+    */
+    void setBufferSize(size_t bufferSize) {
+      if (bufferSize > max_size()) throw std::length_error("Vector size exceeds SizeType");
 
-        // Allocate more space
-        reserve(len);
-      }
+      _capacity = static_cast<SizeType>(bufferSize) | (_capacity & NOT_OWNED);
+    }
 
-      // Copy new vector
-      copyObjects(data(), buffer, len);
+    T* small() { return reinterpret_cast<T*>(&_buffers.small); }
+    const T* small() const { return reinterpret_cast<const T*>(&_buffers.small); }
 
-      _vectorSize = len;
+    /**
+    * @return the capacity of a growth to at least vectorSize elements: at least twice the current one
+    * @throw std::length_error if vectorSize does not fit SizeType
+    */
+    size_t grownSize(size_t vectorSize) const {
+      if (vectorSize > max_size()) throw std::length_error("Vector size exceeds SizeType");
+
+      size_t grown = (vectorSize > 2 * bufferSize() ? vectorSize : 2 * bufferSize());
+      return (grown > max_size() ? max_size() : grown);
     }
 
     /**
-    * Append a C-vector
+    * Append a C-vector, which may be part of this vector
     */
     void append(const T* buffer, size_t len) {
-      reserve(_vectorSize + len);
-      if (len > 0) copyObjects(data() + _vectorSize, buffer, len);
+      if (len == 0) return;
+
+      if (_vectorSize + len > bufferSize()) {
+        // Growing moves the elements, a part of them may be the appended buffer
+        bool inside = (buffer >= data() && buffer < data() + _vectorSize);
+        size_t offset = buffer - data();
+
+        reserve(grownSize(_vectorSize + len));
+        if (inside) buffer = data() + offset;
+      }
+
+      copy(data() + _vectorSize, buffer, len, IsMemcpyable());
 
       _vectorSize += len;
     }
 
     /**
-    * Copy array of objects
+    * Copy-construct elements into uninitialized storage
     */
-    static void copyObjects(T* dst, const T* src, size_t len) {
-      for (size_t i = 0; i < len; ++i) dst[i] = src[i];
+    void copy(T* dst, const T* src, size_t len, std::false_type) {
+      for (size_t i = 0; i < len; ++i) AllocatorTraits::construct(allocator(), dst + i, src[i]);
     }
 
+    void copy(T* dst, const T* src, size_t len, std::true_type) {
+      memcpy(dst, src, len * sizeof(T));
+    }
 
     /**
-    * compare array of objects
+    * Move the elements of another owned vector with a small buffer into the empty small buffer
     */
-    static bool compare(const T* a, const T* b, size_t len) {
+    void moveFrom(Vector& other) {
+      reserve(other._vectorSize);
 
-      for (size_t i = 0; i < len; ++i) if (a[i] != b[i]) return false;
+      relocate(data(), other.data(), other._vectorSize, IsMemcpyable(), std::true_type());
+      _vectorSize = other._vectorSize;
+      other._vectorSize = 0;
+    }
 
-      return true;
+    /**
+    * Move the elements to uninitialized storage, then destroy them.
+    * They are copied if their move constructor may throw
+    */
+    void relocate(T* dst, T* src, size_t len) {
+      relocate(dst, src, len, IsMemcpyable(), std::false_type());
     }
 
-    /// Reuse the pointer stack storage for small vectors
-    struct {
-      T* large;
-      T  small[SmallVectorSize];
-    } _buffers;
+    /**
+    * Move the elements to uninitialized storage, then destroy them
+    * @param moveAlways true to move them even if their move constructor may throw
+    */
+    template <typename MoveAlways>
+    void relocate(T* dst, T* src, size_t len, std::false_type, MoveAlways) {
+      for (size_t i = 0; i < len; ++i) {
+        if (MoveAlways::value) AllocatorTraits::construct(allocator(), dst + i, std::move(src[i]));
+        else AllocatorTraits::construct(allocator(), dst + i, std::move_if_noexcept(src[i]));
+      }
+
+      destroy(src, len);
+    }
+
+    template <typename MoveAlways>
+    void relocate(T* dst, T* src, size_t len, std::true_type, MoveAlways) {
+      if (len) memcpy(dst, src, len * sizeof(T));
+    }
+
+    /**
+    * Shift constructed elements one position up, over the constructed element past them
+    */
+    void shift(T* first, size_t len) {
+      shift(first, len, IsMemcpyable());
+    }
+
+    void shift(T* first, size_t len, std::false_type) {
+      for (T* it = first + len; it != first; --it) *it = std::move(*(it - 1));
+    }
+
+    void shift(T* first, size_t len, std::true_type) {
+      memmove(first + 1, first, len * sizeof(T));
+    }
 
-    /// Whether the instance is owned.
-    /// This happens when the vector operates on its own storage.
-    /// Otherwise, the vector is just an overlay on an external buffer
-    bool _bufferOwned;
+    /**
+    * Destroy elements, their storage stays
+    */
+    void destroy(T* first, size_t len) {
+      if (std::is_trivially_destructible<T>::value) return;
+
+      for (size_t i = 0; i < len; ++i) AllocatorTraits::destroy(allocator(), first + i);
+    }
+
+    /**
+    * Destroy the elements and deallocate the heap buffer if owned
+    */
+    void release() {
+      if (owned()) {
+        destroy(data(), _vectorSize);
+        if (bufferSize() > SmallVectorSize) AllocatorTraits::deallocate(allocator(), _buffers.large, bufferSize());
+      }
+
+      reset();
+    }
+
+    /**
+    * Become an empty owned vector over the small buffer, forgetting the previous storage
+    */
+    void reset() {
+      setOwned(true);
+      setBufferSize(SmallVectorSize);
+      _vectorSize = 0;
+      _buffers.large = nullptr;
+    }
+
+    /// Reuse the pointer stack storage for small vectors.
+    /// The allocator is a base, thus takes no space when stateless
+    struct Buffers : Allocator {
+      Buffers() {}
+      explicit Buffers(const Allocator& allocator) : Allocator(allocator) {}
+      explicit Buffers(Allocator&& allocator) : Allocator(std::move(allocator)) {}
+
+      union {
+        T* large;
+        typename std::aligned_storage<sizeof(T) * (SmallVectorSize ? SmallVectorSize : 1), alignof(T)>::type small;
+      };
+    } _buffers;
 
-    /// Keep track of internal buffer size
-    size_t _bufferSize;
+    /// Keep track of internal buffer size.
+    /// Its top bit is set when the vector is not owned, i.e. just an overlay on an external buffer
+    SizeType _capacity;
 
     /// Keep track of the use vector size
-    size_t _vectorSize;
+    SizeType _vectorSize;
 
     // Make all Vectors friends for accessing private members
-    template <typename U, size_t N>
+    template <typename U, size_t N, typename A, typename S>
     friend class Vector;
   };
 
   /**
   * Stream operator
   */
-  template <typename T, size_t N>
-  std::ostream& operator<<(std::ostream& os, const Vector<T, N>& buffer) {
+  template <typename T, size_t N, typename A, typename S>
+  std::ostream& operator<<(std::ostream& os, const Vector<T, N, A, S>& buffer) {
     for (auto& item : buffer)  os << item;
 
     return os;
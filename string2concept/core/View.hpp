@@ -0,0 +1,147 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+
+#ifndef CONCEPT_VIEW_HPP
+#define CONCEPT_VIEW_HPP
+
+#include <cstddef>
+#include <iostream>
+#include "Elements.hpp"
+
+namespace Concept {
+
+  /**
+  * Non-owning view over a contiguous sequence, a pointer and a length.
+  * It is trivially copyable, allocates nothing and is meant for lookups
+  * that must not materialize a key.
+  */
+  template <typename T>
+  class View {
+
+  public:
+
+    // Defining an iterator over constant values
+    using const_iterator = const T*;
+
+    /**
+    * Default constructor: an empty view
+    */
+    View() : _data(nullptr), _size(0) {}
+
+    /**
+    * Constructor from a buffer
+    * @param data the first element
+    * @param size the number of elements
+    */
+    View(const T* data, size_t size) : _data(data), _size(size) {}
+
+    /**
+    * @return a const iterator pointing to the first element
+    */
+    const_iterator begin() const {
+      return _data;
+    }
+
+    /**
+    * @return a const iterator pointing to the pass-the-end element
+    */
+    const_iterator end() const {
+      return _data + _size;
+    }
+
+    /**
+    * Bracket operator.
+    * @return a constant reference to the item at pos
+    */
+    const T& operator[](size_t pos) const {
+      return _data[pos];
+    }
+
+    /**
+    * @return the viewed buffer
+    */
+    const T* data() const {
+      return _data;
+    }
+
+    /**
+    * @return the number of elements
+    */
+    size_t size() const {
+      return _size;
+    }
+
+    /**
+    * Equality check against any sequence exposing data() and size()
+    */
+    template <typename Sequence>
+    bool operator==(const Sequence& other) const {
+      return equal(*this, other);
+    }
+
+    /**
+    * Inequality check against any sequence exposing data() and size()
+    */
+    template <typename Sequence>
+    bool operator!=(const Sequence& other) const {
+      return !equal(*this, other);
+    }
+
+    /**
+    * Compare two sequences element by element, or with memcmp when their elements allow it
+    */
+    template <typename Sequence1, typename Sequence2>
+    static bool equal(const Sequence1& a, const Sequence2& b) {
+
+      if (a.size() != b.size()) return false;
+
+      return Elements::equal(a.data(), b.data(), a.size());
+    }
+
+  private:
+
+    const T* _data;
+    size_t   _size;
+  };
+
+  /**
+  * Stream operator
+  */
+  template <typename T>
+  std::ostream& operator<<(std::ostream& os, const View<T>& view) {
+    for (auto& item : view)  os << item;
+
+    return os;
+  }
+
+} //end namespace Concept
+
+#endif
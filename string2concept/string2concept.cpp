@@ -26,17 +26,38 @@
 
 #include "stdafx.h"
 
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
 
+#include "benchmarks/BenchBatch.hpp"
+#include "benchmarks/BenchEngines.hpp"
+#include "benchmarks/BenchHash.hpp"
+#include "benchmarks/BenchHashTable.hpp"
+#include "benchmarks/BenchVector.hpp"
+#include "core/Benchmark.hpp"
 #include "core/String.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Vector.hpp"
+#include "core/View.hpp"
+#include "tests/TestArena.hpp"
+#include "tests/TestCompiledDictionary.hpp"
 #include "tests/TestConceptExtractor.hpp"
+#include "tests/TestFlatHashTable.hpp"
 #include "tests/TestHash.hpp"
 #include "tests/TestHashTable.hpp"
+#include "tests/TestNGramConceptExtractor.hpp"
+#include "tests/TestAhoCorasickConceptExtractor.hpp"
+#include "tests/TestPerfectHashTable.hpp"
 #include "tests/TestString.hpp"
+#include "tests/TestThreadPool.hpp"
 #include "tests/TestVector.hpp"
 #include "tests/TestWords.hpp"
+#include "tests/TestNormalizer.hpp"
+#include "tests/TestUnicodeFolder.hpp"
 
 #include "ConceptExtractor.hpp"
 
@@ -49,8 +70,18 @@ inline int usage(int argc, char** argv, int index) {
                           "Options:\n"
                           "-c, --concept <concept list path> <text> :\n" 
                           "    Find in <text> those of the concepts listed in <concept list path> .\n"
+                          "-B, --batch <concept list path> <text list path> [<thread count>] :\n"
+                          "    Find in every line of <text list path> those of the concepts listed in <concept list path>,\n"
+                          "    over <thread count> threads, by default one per hardware thread.\n"
+                          "-s, --stream <concept list path> [<text path>] :\n"
+                          "    Find in <text path>, or in the standard input, those of the concepts listed in <concept list path>,\n"
+                          "    chunk by chunk, white space separating words. Concepts are printed as soon as found.\n"
+                          "-C, --compile <concept list path> <output path> :\n"
+                          "    Compile the concepts listed in <concept list path> to a dictionary file,\n"
+                          "    which --concepts maps instead of parsing.\n"
                           "-h, --help    : Show this help\n"
-                          "-t, --test: Run unit tests\n";
+                          "-t, --test: Run unit tests\n"
+                          "-b, --bench [<concept count>] : Run benchmarks over synthetic concepts\n";
 
   std::cout << argv[0] << usageStr << std::endl;
   return 0;
@@ -66,13 +97,50 @@ int runtests(int argc, char** argv, int index) {
   allTests.add(std::make_shared<Concept::TestString>());
   allTests.add(std::make_shared<Concept::TestVector>());
   allTests.add(std::make_shared<Concept::TestHash>());
+  allTests.add(std::make_shared<Concept::TestThreadPool>());
+  allTests.add(std::make_shared<Concept::TestArena>());
   allTests.add(std::make_shared<Concept::TestHashTable>());
+  allTests.add(std::make_shared<Concept::TestFlatHashTable>());
+  allTests.add(std::make_shared<Concept::TestPerfectHashTable>());
   allTests.add(std::make_shared<Concept::TestWords>());
+  allTests.add(std::make_shared<Concept::TestNormalizer>());
+  allTests.add(std::make_shared<Concept::TestUnicodeFolder>());
   allTests.add(std::make_shared<Concept::TestConceptExtractor>());
+  allTests.add(std::make_shared<Concept::TestCompiledDictionary>());
+  allTests.add(std::make_shared<Concept::TestNGramConceptExtractor>());
+  allTests.add(std::make_shared<Concept::TestAhoCorasickConceptExtractor>());
 
   return !allTests.run();
 }
 
+/**
+* Run benchmarks
+*/
+int runbenchmarks(int argc, char** argv, int index) {
+
+  size_t scale = Concept::Benchmark::DEFAULT_BENCHMARK_SCALE;
+  if (index + 1 < argc) scale = static_cast<size_t>(strtoull(argv[index + 1], nullptr, 10));
+
+  Concept::Benchmark::BenchmarkFixture allBenchmarks;
+  allBenchmarks.add(std::make_shared<Concept::BenchVector>());
+  allBenchmarks.add(std::make_shared<Concept::BenchHash>());
+  allBenchmarks.add(std::make_shared<Concept::BenchHashTable>());
+  allBenchmarks.add(std::make_shared<Concept::BenchEngines>());
+  allBenchmarks.add(std::make_shared<Concept::BenchBatch>());
+
+  allBenchmarks.run(scale);
+
+  return 0;
+}
+
+/**
+* Report a concept file that could not be loaded
+*/
+inline int cannotLoad(const char* conceptFilePath) {
+  std::cerr << "Cannot load " << conceptFilePath << std::endl;
+  return 1;
+}
+
 /**
 * Extract concepts from text
 */
@@ -81,6 +149,7 @@ inline int extractConcepts(int argc, char** argv, int index) {
   if (index + 2 >= argc) return usage(argc, argv, 0);
 
   Concept::ConceptExtractor extractor(argv[index + 1]);
+  if (!extractor.loaded()) return cannotLoad(argv[index + 1]);
   auto concepts = extractor.get(Concept::String<>(argv[index + 2]));
 
   auto len = concepts.size();
@@ -93,6 +162,89 @@ inline int extractConcepts(int argc, char** argv, int index) {
   return 0;
 }
 
+/**
+* Extract concepts from every line of a text file
+*/
+inline int extractBatch(int argc, char** argv, int index) {
+
+  if (index + 2 >= argc) return usage(argc, argv, 0);
+
+  size_t threadCount = 0;
+  if (index + 3 < argc) threadCount = static_cast<size_t>(strtoull(argv[index + 3], nullptr, 10));
+
+  std::ifstream textFile(argv[index + 2]);
+  if (!textFile) {
+    std::cerr << "Cannot read " << argv[index + 2] << std::endl;
+    return 1;
+  }
+
+  Concept::Vector<Concept::String<> > texts;
+  std::string line;
+  while (std::getline(textFile, line)) texts.push_back(line.c_str());
+
+  Concept::ConceptExtractor extractor(argv[index + 1]);
+  if (!extractor.loaded()) return cannotLoad(argv[index + 1]);
+  Concept::ThreadPool pool(threadCount);
+
+  auto results = extractor.get(Concept::View<Concept::String<> >(texts.data(), texts.size()), pool);
+
+  // One line of concepts per text line
+  for (auto& concepts : results) {
+    for (size_t i = 0; i < concepts.size(); ++i) std::cout << (i ? "\t" : "") << concepts[i];
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
+
+/**
+* Extract concepts from a stream
+*/
+inline int extractStream(int argc, char** argv, int index) {
+
+  if (index + 1 >= argc) return usage(argc, argv, 0);
+
+  // Line breaks and tabs separate words across the lines of the stream
+  Concept::ExtendedConceptExtractor extractor(argv[index + 1]);
+  if (!extractor.loaded()) return cannotLoad(argv[index + 1]);
+
+  auto print = [](const Concept::View<char>& concept) { std::cout << concept << std::endl; };
+
+  // Read the standard input without a text path
+  if (index + 2 >= argc) {
+    extractor.stream(0, print);
+    return 0;
+  }
+
+  std::ifstream textFile(argv[index + 2], std::ios::binary);
+  if (!textFile) {
+    std::cerr << "Cannot read " << argv[index + 2] << std::endl;
+    return 1;
+  }
+
+  extractor.stream(textFile, print);
+
+  return 0;
+}
+
+/**
+* Compile a concept list
+*/
+inline int compileConcepts(int argc, char** argv, int index) {
+
+  if (index + 2 >= argc) return usage(argc, argv, 0);
+
+  Concept::ConceptExtractor extractor(argv[index + 1]);
+  if (!extractor.loaded()) return cannotLoad(argv[index + 1]);
+
+  if (!extractor.compile(argv[index + 2])) {
+    std::cerr << "Cannot write " << argv[index + 2] << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
 /**
 * Execute an option handler
 * @param[in] option the option to check
@@ -126,10 +278,18 @@ int main(int argc, char** argv) {
     for (; i < argc; ++i) {
         if (executeOption("-t",         argc, argv, i, &runtests, status))        break;
         if (executeOption("--test",    argc, argv, i, &runtests, status))        break;
+        if (executeOption("-b",         argc, argv, i, &runbenchmarks, status))   break;
+        if (executeOption("--bench",    argc, argv, i, &runbenchmarks, status))   break;
         if (executeOption("-h",         argc, argv, i, &usage, status))           break;
         if (executeOption("--help",     argc, argv, i, &usage, status))           break;
         if (executeOption("-c",         argc, argv, i, &extractConcepts, status)) break;
         if (executeOption("--concepts", argc, argv, i, &extractConcepts, status)) break;
+        if (executeOption("-B",         argc, argv, i, &extractBatch, status))    break;
+        if (executeOption("--batch",    argc, argv, i, &extractBatch, status))    break;
+        if (executeOption("-s",         argc, argv, i, &extractStream, status))   break;
+        if (executeOption("--stream",   argc, argv, i, &extractStream, status))   break;
+        if (executeOption("-C",         argc, argv, i, &compileConcepts, status)) break;
+        if (executeOption("--compile",  argc, argv, i, &compileConcepts, status)) break;
       }
     // No valid options
     if (i == argc) status = usage(argc, argv, 0);
@@ -0,0 +1,206 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "../AhoCorasickConceptExtractor.hpp"
+#include "../ConceptExtractor.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "TestAhoCorasickConceptExtractor.hpp"
+
+namespace Concept {
+
+  namespace {
+    /**
+    * Order matches by first word then by word count, as ConceptExtractor reports them
+    */
+    struct MatchOrder {
+      bool operator()(const Match& match1, const Match& match2) const {
+        if (match1.wordIndex != match2.wordIndex) return match1.wordIndex < match2.wordIndex;
+        return match1.end < match2.end;
+      }
+    };
+
+    /**
+    * @return the number of matches identical in both vectors, once ordered alike
+    */
+    size_t identicalMatches(Vector<Match>& matches, Vector<Match>& expected) {
+      std::sort(matches.begin(), matches.end(), MatchOrder());
+      std::sort(expected.begin(), expected.end(), MatchOrder());
+
+      size_t identical = 0;
+      for (size_t i = 0; i < matches.size() && i < expected.size(); ++i) {
+        identical += (matches[i].begin == expected[i].begin && matches[i].end == expected[i].end &&
+                      matches[i].wordIndex == expected[i].wordIndex && matches[i].conceptId == expected[i].conceptId);
+      }
+
+      return identical;
+    }
+  }
+
+  const char* TestAhoCorasickConceptExtractor::name() const {
+    return "Checking Concept::AhoCorasickConceptExtractor";
+  }
+
+  void TestAhoCorasickConceptExtractor::operator()() {
+
+    {
+      // Test concept extraction
+      AhoCorasickConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "East Asian Food",
+        "Asian Food Market",
+        "Food"
+      };
+
+      ASSERT_EQUAL(6UL, extractor.conceptCount());
+      ASSERT_EQUAL(6UL, extractor.vocabularySize());
+      ASSERT_TRUE(!extractor.frozen());
+
+      String<> input = "Which restaurants do West Indian or East Asian food?";
+      auto concepts = extractor.get(input);
+
+      // The automaton is compiled by the first extraction
+      ASSERT_TRUE(extractor.frozen());
+
+      // Ordered by last word, then from the longest
+      if (ASSERT_EQUAL(5UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("Indian", concepts[1]);
+        ASSERT_EQUAL("East Asian", concepts[2]);
+        ASSERT_EQUAL("East Asian Food", concepts[3]);
+        ASSERT_EQUAL("Food", concepts[4]);
+      }
+
+      // Failure links: "asian food" then "market" completes the concept started after "east"
+      concepts = extractor.get(String<>("east asian food market"));
+      if (ASSERT_EQUAL(4UL, concepts.size())) {
+        ASSERT_EQUAL("East Asian", concepts[0]);
+        ASSERT_EQUAL("East Asian Food", concepts[1]);
+        ASSERT_EQUAL("Food", concepts[2]);
+        ASSERT_EQUAL("Asian Food Market", concepts[3]);
+      }
+
+      // Unknown words reset the automaton
+      ASSERT_EQUAL(1UL, extractor.get(String<>("asian food oriental market")).size());
+      ASSERT_EQUAL(0UL, extractor.get(String<>("")).size());
+      ASSERT_EQUAL(0UL, extractor.get(String<>("nothing to find here")).size());
+
+      // A concept added again in another case keeps its ID
+      extractor.addConcept("EAST ASIAN");
+      ASSERT_EQUAL(6UL, extractor.conceptCount());
+      ASSERT_EQUAL(String<>("EAST ASIAN"), String<>(extractor.concept(2)));
+
+      // Adding a concept invalidates the automaton
+      extractor.addConcept("Oriental Market");
+      ASSERT_TRUE(!extractor.frozen());
+      ASSERT_EQUAL(2UL, extractor.get(String<>("asian food oriental market")).size());
+      ASSERT_TRUE(extractor.freeze());
+      ASSERT_TRUE(extractor.frozen());
+    }
+
+    {
+      // Test repeated and nested words
+      AhoCorasickConceptExtractor extractor { "a a", "a a b", "a b", "b" };
+
+      // Words 0-1, 1-2, 2-3, then 2-4 ("a a b"), 3-4 ("a b") and 4 ("b")
+      auto matches = extractor.matches(String<>("a a a a b"));
+      ASSERT_EQUAL(6UL, matches.size());
+    }
+
+    {
+      // Test match positions against the hashed extractor
+      const char* concepts[] = { "Indian", "West Indian", "East Asian", "East Asian Food", "Thai", "Asian" };
+      AhoCorasickConceptExtractor extractor;
+      ConceptExtractor reference;
+      for (auto concept : concepts) {
+        extractor.addConcept(concept);
+        reference.addConcept(concept);
+      }
+
+      String<> input = "  Which restaurants do West Indian, or East   Asian food? thai";
+      auto matches = extractor.matches(input);
+      auto expected = reference.matches(input);
+
+      ASSERT_EQUAL(6UL, matches.size());
+      ASSERT_EQUAL(6UL, identicalMatches(matches, expected));
+    }
+
+    {
+      // Test many concepts sharing prefixes, growing the double array
+      AhoCorasickConceptExtractor extractor;
+      ConceptExtractor reference;
+      for (size_t i = 0; i < 5000; ++i) {
+        String<> concept = "concept number ";
+        concept += std::to_string(i).c_str();
+        extractor.addConcept(concept.c_str());
+        reference.addConcept(concept.c_str());
+
+        concept = std::to_string(i % 97).c_str();
+        concept += " number ";
+        concept += std::to_string(i).c_str();
+        extractor.addConcept(concept.c_str());
+        reference.addConcept(concept.c_str());
+      }
+
+      ASSERT_EQUAL(reference.conceptCount(), extractor.conceptCount());
+      ASSERT_TRUE(extractor.freeze());
+      ASSERT_TRUE(extractor.cellCount() >= extractor.conceptCount());
+
+      String<> input = "find concept number 4321 and concept number 12 or concept 7 then 2 number 2 number 99";
+      auto matches = extractor.matches(input);
+      auto expected = reference.matches(input);
+
+      ASSERT_EQUAL(expected.size(), matches.size());
+      ASSERT_EQUAL(expected.size(), identicalMatches(matches, expected));
+    }
+
+    {
+      // Test a concept list file: lines of any length, CRLF line breaks
+      std::string longConcept(2000, 'x');
+      const char* path = "TestAhoCorasickConceptExtractor.txt";
+      std::ofstream(path, std::ios::binary) << "Indian\r\n" << longConcept << "\nEast Asian\r\nSushi\n";
+      AhoCorasickConceptExtractor extractor(path);
+      std::remove(path);
+
+      ASSERT_EQUAL(4UL, extractor.conceptCount());
+      ASSERT_EQUAL(3UL, extractor.get(String<>("Indian or East Asian sushi")).size());
+      ASSERT_EQUAL(1UL, extractor.get(String<>(longConcept.c_str())).size());
+    }
+  }
+
+} //end namespace Concept
@@ -0,0 +1,105 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <cstdint>
+#include <string>
+#include "../core/Arena.hpp"
+#include "../core/HashTable.hpp"
+#include "../core/String.hpp"
+#include "TestArena.hpp"
+
+namespace Concept {
+
+  const char* TestArena::name() const {
+    return "Checking Concept::Arena";
+  }
+
+  void TestArena::operator()() {
+
+    {
+      // Copies keep their characters while the arena grows
+      Arena arena;
+      ASSERT_EQUAL(0UL, arena.capacity());
+
+      Vector<View<char> > copies;
+      String<> text = "East Asian";
+      for (size_t i = 0; i < 10000; ++i) copies.push_back(arena.copy(View<char>(text.c_str(), text.length())));
+
+      size_t same = 0;
+      for (auto& copy : copies) same += (copy == View<char>(text.c_str(), text.length()));
+      ASSERT_EQUAL(10000UL, same);
+      ASSERT_EQUAL(100000UL, arena.size());
+      ASSERT_TRUE(arena.capacity() >= arena.size());
+      ASSERT_TRUE(copies[0].data() != copies[1].data());
+
+      ASSERT_EQUAL(0UL, arena.copy(View<char>()).size());
+    }
+
+    {
+      // Objects are aligned, and large ones get their own block
+      Arena arena;
+      arena.allocate(1, 1);
+
+      uint64_t* number = arena.create<uint64_t>(42);
+      ASSERT_EQUAL(0UL, reinterpret_cast<size_t>(number) % alignof(uint64_t));
+      ASSERT_EQUAL(42UL, static_cast<size_t>(*number));
+
+      char* large = static_cast<char*>(arena.allocate(Arena::MAX_BLOCK_SIZE, 1));
+      large[Arena::MAX_BLOCK_SIZE - 1] = 'x';
+      ASSERT_EQUAL(42UL, static_cast<size_t>(*arena.create<uint64_t>(42)));
+
+      arena.clear();
+      ASSERT_EQUAL(0UL, arena.size());
+      ASSERT_EQUAL(0UL, arena.capacity());
+    }
+
+    {
+      // Hash table nodes come from an arena. Entries that own memory are destroyed with the table
+      HashTable<Vector<char>, Vector<char>, 2> table;
+      for (size_t i = 0; i < 1000; ++i) {
+        String<> key = String<>("concept ") + String<>(std::to_string(i).c_str());
+        table[Vector<char>(key)] = Vector<char>(key);
+      }
+
+      ASSERT_EQUAL(1000UL, table.size());
+
+      size_t same = 0;
+      table.forEach([&same](const std::pair<Vector<char>, Vector<char> >& entry) { same += (entry.first == entry.second); });
+      ASSERT_EQUAL(1000UL, same);
+
+      table.clear();
+      ASSERT_EQUAL(0UL, table.size());
+      ASSERT_TRUE(table.end() == table.find(Vector<char>(String<>("concept 1"))));
+    }
+  }
+
+} //end namespace Concept
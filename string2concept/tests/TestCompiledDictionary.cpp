@@ -0,0 +1,195 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include "../core/HashTable.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "../CompiledDictionary.hpp"
+#include "../ConceptExtractor.hpp"
+#include "TestCompiledDictionary.hpp"
+
+namespace Concept {
+
+  const char* TestCompiledDictionary::name() const {
+    return "Checking Concept::CompiledDictionary";
+  }
+
+  void TestCompiledDictionary::operator()() {
+
+    using KeyHash    = Hash<Vector<char>, ConceptExtractor::WordHash>;
+    using Dictionary = CompiledDictionary<KeyHash>;
+    using Value      = ConceptEntry;
+
+    const char* path = "TestCompiledDictionary.s2c";
+
+    {
+      // Compile a Hash table, then map it
+      HashTable<Vector<char>, Value, DEFAULT_SMALL_HASHTABLE_BUCKET_COUNT, KeyHash> source;
+      Vector<String<> > concepts = { "Indian", "Thai", "Sushi", "East Asian", "West Indian" };
+      for (size_t id = 0; id < concepts.size(); ++id) {
+        Value& value = source[Vector<char>(concepts[id])];
+        value.conceptId = static_cast<ConceptId>(id);
+        value.addWordCount(1);
+        value.addWordCount(concepts[id].length() > 6 ? 2 : 3);
+      }
+
+      ASSERT_TRUE(Dictionary::compile(source, concepts.size(),
+                                      [&concepts](size_t id) -> const String<>& { return concepts[id]; }, path));
+      ASSERT_TRUE(Dictionary::isCompiled(path));
+
+      Dictionary dictionary;
+      ASSERT_TRUE(dictionary.open(path));
+      ASSERT_EQUAL(5UL, dictionary.size());
+      ASSERT_EQUAL(5UL, dictionary.conceptCount());
+      ASSERT_EQUAL(3UL, dictionary.maxWordCount());
+
+      auto entry = dictionary.find(Vector<char>(String<>("East Asian")));
+      ASSERT_TRUE(entry != dictionary.end());
+      ASSERT_EQUAL(3UL, static_cast<size_t>(entry->second.conceptId));
+      ASSERT_EQUAL(String<>("East Asian"), String<>(dictionary.concept(entry->second.conceptId)));
+      ASSERT_TRUE(entry->second.isConcept());
+      ASSERT_EQUAL(3UL, static_cast<size_t>(entry->second.wordCounts));
+      ASSERT_EQUAL(2UL, entry->second.maxWordCount());
+
+      // Lookup by view with a precomputed hash
+      const char* text = "Where can I find good Sushi";
+      View<char> view(text + 22, 5);
+      ASSERT_EQUAL(2UL, static_cast<size_t>(dictionary.find(view, KeyHash()(view))->second.conceptId));
+      ASSERT_TRUE(dictionary.end() == dictionary.find(Vector<char>(String<>("sushi"))));
+
+      size_t count = 0;
+      dictionary.forEach([&count](const Dictionary::Entry& entry) { count += countBits(entry.second.wordCounts); });
+      ASSERT_EQUAL(10UL, count);
+
+      dictionary.close();
+      ASSERT_TRUE(!dictionary.isOpen());
+      ASSERT_TRUE(dictionary.end() == dictionary.find(view));
+    }
+
+    {
+      // Concept lists are not compiled dictionaries
+      std::ofstream("TestCompiledDictionary.txt") << "Thai" << std::endl;
+      Dictionary dictionary;
+      ASSERT_TRUE(!Dictionary::isCompiled("TestCompiledDictionary.txt"));
+      ASSERT_TRUE(!dictionary.open("TestCompiledDictionary.txt"));
+      ASSERT_TRUE(!dictionary.open("TestCompiledDictionary.missing"));
+      std::remove("TestCompiledDictionary.txt");
+    }
+
+    {
+      // Headers with a full table or out of range sections are rejected
+      ConceptExtractor source({ "Indian", "Thai", "Sushi" });
+      ASSERT_TRUE(source.compile(path));
+
+      // Entry count, then slot count, after the magic, version, byte order and hash check
+      const std::streamoff entryCountOffset = 24;
+      uint64_t slotCount = 0;
+      std::ifstream(path, std::ios::binary).seekg(entryCountOffset + 8).read(reinterpret_cast<char*>(&slotCount), sizeof(slotCount));
+
+      std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).seekp(entryCountOffset)
+        .write(reinterpret_cast<const char*>(&slotCount), sizeof(slotCount));
+      Dictionary dictionary;
+      ASSERT_TRUE(!dictionary.open(path));
+
+      uint64_t hugeSlotCount = 1ULL << 62;
+      ASSERT_TRUE(source.compile(path));
+      std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).seekp(entryCountOffset + 8)
+        .write(reinterpret_cast<const char*>(&hugeSlotCount), sizeof(hugeSlotCount));
+      ASSERT_TRUE(!dictionary.open(path));
+
+      // Keys and surface forms out of the string pool are rejected too.
+      // Slots of 32 bytes follow the 80-byte header: hash, key offset, key length, concept ID, reserved, word counts
+      const size_t headerSize = 80;
+      const size_t slotSize = 32;
+      uint32_t outOfPool = 0xFFFFFF00U;
+
+      ASSERT_TRUE(source.compile(path));
+      size_t slot = 0;
+      for (; slot < 16; ++slot) {
+        uint64_t wordCounts = 0;
+        std::ifstream(path, std::ios::binary).seekg(headerSize + slot * slotSize + 24).read(reinterpret_cast<char*>(&wordCounts), sizeof(wordCounts));
+        if (wordCounts != 0) break;
+      }
+
+      std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).seekp(headerSize + slot * slotSize + 8)
+        .write(reinterpret_cast<const char*>(&outOfPool), sizeof(outOfPool));
+      ASSERT_TRUE(!dictionary.open(path));
+
+      // The concept table follows the 16 slots of a small dictionary: offset and length of every surface form
+      ASSERT_TRUE(source.compile(path));
+      std::fstream(path, std::ios::binary | std::ios::in | std::ios::out).seekp(headerSize + 16 * slotSize + 4)
+        .write(reinterpret_cast<const char*>(&outOfPool), sizeof(outOfPool));
+      ASSERT_TRUE(!dictionary.open(path));
+
+      // Extractors report the files they cannot load
+      ASSERT_TRUE(!ConceptExtractor(path).loaded());
+      ASSERT_TRUE(!ConceptExtractor("TestCompiledDictionary.missing").loaded());
+    }
+
+    {
+      // Round trip through an extractor
+      ConceptExtractor source({ "Indian", "Thai", "Sushi", "East Asian", "East Asian Food", "West Indian" });
+      ASSERT_TRUE(source.compile(path));
+
+      ConceptExtractor extractor(path);
+      ASSERT_TRUE(extractor.loaded());
+      ASSERT_TRUE(extractor.frozen());
+
+      auto concepts = extractor.get(String<>("Which restaurants do West Indian or East Asian food?"));
+      ASSERT_EQUAL(4UL, concepts.size());
+      ASSERT_EQUAL(String<>("West Indian"), concepts[0]);
+      ASSERT_EQUAL(String<>("Indian"), concepts[1]);
+      ASSERT_EQUAL(String<>("East Asian"), concepts[2]);
+      ASSERT_EQUAL(String<>("East Asian Food"), concepts[3]);
+
+      // Concept IDs survive compilation
+      ASSERT_EQUAL(6UL, extractor.conceptCount());
+      ASSERT_EQUAL(String<>("West Indian"), String<>(extractor.concept(5)));
+      ASSERT_EQUAL(4UL, static_cast<size_t>(extractor.matches(String<>("East Asian food"))[1].conceptId));
+
+      // Adding a concept copies the mapped dictionary back to the Hash table
+      extractor.addConcept("Food");
+      ASSERT_TRUE(!extractor.frozen());
+      concepts = extractor.get(String<>("Which restaurants do West Indian or East Asian food?"));
+      ASSERT_EQUAL(5UL, concepts.size());
+      ASSERT_EQUAL(String<>("Food"), concepts[4]);
+      ASSERT_EQUAL(7UL, extractor.conceptCount());
+      ASSERT_EQUAL(String<>("West Indian"), String<>(extractor.concept(5)));
+    }
+
+    std::remove(path);
+  }
+
+} //end namespace Concept
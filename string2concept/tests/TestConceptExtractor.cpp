@@ -26,12 +26,42 @@
 
 #include "stdafx.h"
 
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
 #include "../ConceptExtractor.hpp"
 #include "../core/String.hpp"
+#include "../core/ThreadPool.hpp"
+#include "../core/Vector.hpp"
+#include "../core/View.hpp"
 #include "TestConceptExtractor.hpp"
 
 namespace Concept {
 
+  namespace {
+    /**
+    * @return the number of chunk sizes, from 1 to maxChunkSize, streaming the concepts found by get() in the same order
+    */
+    template <typename Extractor>
+    size_t streamedLikeGet(const Extractor& extractor, const char* text, size_t maxChunkSize) {
+      auto expected = extractor.get(String<>(text));
+      size_t identical = 0;
+
+      for (size_t chunkSize = 1; chunkSize <= maxChunkSize; ++chunkSize) {
+        std::istringstream input(text);
+        Vector<String<> > concepts;
+        extractor.stream(input, [&concepts](const View<char>& concept) { concepts.push_back(concept); }, chunkSize);
+
+        bool same = (concepts.size() == expected.size());
+        for (size_t i = 0; same && i < concepts.size(); ++i) same = (concepts[i] == expected[i]);
+        identical += same;
+      }
+
+      return identical;
+    }
+  }
+
   const char* TestConceptExtractor::name() const {
     return "Checking Concept::ConceptExtractor";
   }
@@ -104,6 +134,337 @@ namespace Concept {
       ASSERT_EQUAL(0UL, concepts.size());
     }
 
+    {
+      // Test overlapping concepts of various word counts
+      ConceptExtractor extractor {
+        "East Asian",
+        "East Asian Food",
+        "Asian Food Market",
+        "Food"
+      };
+
+      String<> input = "Where is the east asian food market";
+      auto concepts = extractor.get(input);
+
+      if (ASSERT_EQUAL(4UL, concepts.size())) {
+        ASSERT_EQUAL("East Asian", concepts[0]);
+        ASSERT_EQUAL("East Asian Food", concepts[1]);
+        ASSERT_EQUAL("Asian Food Market", concepts[2]);
+        ASSERT_EQUAL("Food", concepts[3]);
+      }
+
+      input = "Asian market";
+      concepts = extractor.get(input);
+      ASSERT_EQUAL(0UL, concepts.size());
+    }
+
+    {
+      // Test concept extraction over a frozen dictionary
+      ConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "East Asian Food"
+      };
+
+      ASSERT_TRUE(extractor.freeze());
+      ASSERT_TRUE(extractor.frozen());
+
+      String<> input = "Which restaurants do West Indian or East Asian food";
+      auto concepts = extractor.get(input);
+
+      if (ASSERT_EQUAL(4UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("Indian", concepts[1]);
+        ASSERT_EQUAL("East Asian", concepts[2]);
+        ASSERT_EQUAL("East Asian Food", concepts[3]);
+      }
+
+      input = "Where can I find good sushi";
+      ASSERT_EQUAL(0UL, extractor.get(input).size());
+
+      // Adding a concept thaws the dictionary
+      extractor.addConcept("Sushi");
+      ASSERT_TRUE(!extractor.frozen());
+
+      concepts = extractor.get(input);
+      if (ASSERT_EQUAL(1UL, concepts.size()))
+        ASSERT_EQUAL("Sushi", concepts[0]);
+
+      input = "Which restaurants do West Indian food";
+      ASSERT_EQUAL(2UL, extractor.get(input).size());
+    }
+
+    {
+      // Test concept extraction over an open-addressing Hash table
+      FlatConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "East Asian Food"
+      };
+
+      String<> input = "Which restaurants do West Indian or East Asian food";
+      auto concepts = extractor.get(input);
+
+      if (ASSERT_EQUAL(4UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("Indian", concepts[1]);
+        ASSERT_EQUAL("East Asian", concepts[2]);
+        ASSERT_EQUAL("East Asian Food", concepts[3]);
+      }
+    }
+
+    {
+      // Test batch extraction over a pool of threads
+      const ConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "Sushi"
+      };
+
+      const char* texts[] = { "Which restaurants do West Indian or East Asian food",
+                              "Where can I find good sushi",
+                              "Nothing to find here" };
+      Vector<String<> > inputs;
+      for (size_t i = 0; i < 300; ++i) inputs.push_back(texts[i % 3]);
+
+      ThreadPool pool(4);
+      auto results = extractor.get(View<String<> >(inputs.data(), inputs.size()), pool);
+
+      size_t expected = 0;
+      for (size_t i = 0; i < results.size(); ++i) {
+        auto concepts = extractor.get(inputs[i]);
+        expected += (results[i].size() == concepts.size() &&
+                     (concepts.size() == 0 || results[i][concepts.size() - 1] == *concepts.last()));
+      }
+
+      ASSERT_EQUAL(300UL, results.size());
+      ASSERT_EQUAL(300UL, expected);
+      ASSERT_EQUAL(3UL, results[0].size());
+      ASSERT_EQUAL("Sushi", results[1][0]);
+      ASSERT_EQUAL(0UL, results[299].size());
+    }
+
+    {
+      // Test match positions and concept IDs
+      ConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "East Asian Food",
+        "Thai"
+      };
+
+      ASSERT_EQUAL(5UL, extractor.conceptCount());
+      ASSERT_EQUAL(String<>("East Asian"), String<>(extractor.concept(2)));
+
+      // A concept added again in another case keeps its ID
+      extractor.addConcept("THAI");
+      ASSERT_EQUAL(5UL, extractor.conceptCount());
+      ASSERT_EQUAL(String<>("THAI"), String<>(extractor.concept(4)));
+
+      String<> input = "  Which restaurants do West Indian, or East   Asian food?";
+      auto matches = extractor.matches(input);
+
+      if (ASSERT_EQUAL(4UL, matches.size())) {
+        ASSERT_EQUAL(1UL, static_cast<size_t>(matches[0].conceptId));
+        ASSERT_EQUAL(String<>("West Indian"), String<>(View<char>(input.c_str() + matches[0].begin,
+                                                                   matches[0].end - matches[0].begin)));
+        ASSERT_EQUAL(3UL, static_cast<size_t>(matches[0].wordIndex));
+        ASSERT_EQUAL(0UL, static_cast<size_t>(matches[1].conceptId));
+        ASSERT_EQUAL(String<>("Indian"), String<>(View<char>(input.c_str() + matches[1].begin,
+                                                              matches[1].end - matches[1].begin)));
+        ASSERT_EQUAL(2UL, static_cast<size_t>(matches[2].conceptId));
+        ASSERT_EQUAL(String<>("East   Asian"), String<>(View<char>(input.c_str() + matches[2].begin,
+                                                                    matches[2].end - matches[2].begin)));
+        ASSERT_EQUAL(3UL, static_cast<size_t>(matches[3].conceptId));
+        ASSERT_EQUAL(String<>("East   Asian food"), String<>(View<char>(input.c_str() + matches[3].begin,
+                                                                         matches[3].end - matches[3].begin)));
+      }
+
+      // The visitor stores nothing
+      size_t count = 0;
+      extractor.forEachMatch(input, [&count](const ConceptExtractor::Match& match) { count += match.wordIndex; });
+      ASSERT_EQUAL(3UL + 4UL + 6UL + 6UL, count);
+
+      // Matches survive freezing
+      ASSERT_TRUE(extractor.freeze());
+      ASSERT_EQUAL(String<>("THAI"), String<>(extractor.concept(extractor.matches(String<>("thai"))[0].conceptId)));
+    }
+
+    {
+      // Test the bounds of the word count mask: 64 words, but not 65
+      String<> longest = "w";
+      for (size_t i = 1; i < ConceptExtractor::MAX_CONCEPT_WORD_COUNT; ++i) longest += " w";
+      String<> tooLong = longest + " w";
+
+      ConceptExtractor extractor;
+      extractor.addConcept(tooLong.c_str());
+      ASSERT_EQUAL(0UL, extractor.conceptCount());
+
+      extractor.addConcept(longest.c_str());
+      extractor.addConcept("w w");
+      ASSERT_EQUAL(2UL, extractor.conceptCount());
+
+      // 65 words hold two 64-word matches, and 64 two-word ones
+      auto matches = extractor.matches(tooLong);
+      if (ASSERT_EQUAL(66UL, matches.size()))
+        ASSERT_EQUAL(longest.length(), static_cast<size_t>(matches[1].end - matches[1].begin));
+    }
+
+    {
+      // Test streaming extraction, with concepts straddling chunks
+      ConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "East Asian Food Market",
+        "Sushi"
+      };
+
+      const char* text = "Which restaurants do West Indian, or East   Asian food market? Sushi! East Asian";
+      ASSERT_EQUAL(6UL, extractor.get(String<>(text)).size());
+
+      // Every chunk size yields the same concepts in the same order
+      ASSERT_EQUAL(40UL, streamedLikeGet(extractor, text, 40));
+
+      // Line breaks and tabs separate words as the text policy says, in streams as in get()
+      const char* lines = "Which restaurants do West Indian or East\tAsian food market?\r\nSushi East Asian";
+      ASSERT_EQUAL(3UL, extractor.get(String<>(lines)).size());
+      ASSERT_EQUAL(40UL, streamedLikeGet(extractor, lines, 40));
+
+      ExtendedConceptExtractor extendedExtractor { "Indian", "West Indian", "East Asian", "East Asian Food Market", "Sushi" };
+      ASSERT_EQUAL(6UL, extendedExtractor.get(String<>(lines)).size());
+      ASSERT_EQUAL(40UL, streamedLikeGet(extendedExtractor, lines, 40));
+
+      // Words longer than chunks
+      std::istringstream input("sushi sushisushi sushi");
+      size_t count = 0;
+      extractor.stream(input, [&count](const View<char>&) { ++count; }, 3);
+      ASSERT_EQUAL(2UL, count);
+
+      // Words too long to be part of a concept are skipped, and break the concepts around them.
+      // Punctuation is dropped before words are measured
+      std::string run = "East Asian " + std::string(100000, 'x') + " Sushi East " + std::string(5000, 'y') +
+                        " Asian sushi" + std::string(20000, '!') + " end";
+      std::istringstream longRun(run);
+      Vector<String<> > concepts;
+      extractor.stream(longRun, [&concepts](const View<char>& concept) { concepts.push_back(concept); }, 7);
+
+      if (ASSERT_EQUAL(3UL, concepts.size())) {
+        ASSERT_EQUAL(String<>("East Asian"), concepts[0]);
+        ASSERT_EQUAL(String<>("Sushi"), concepts[1]);
+        ASSERT_EQUAL(String<>("Sushi"), concepts[2]);
+      }
+      ASSERT_EQUAL(3UL, extractor.get(String<>(run.c_str())).size());
+    }
+
+    {
+      // Test the bulk build from a concept list: lines of any length, CRLF line breaks, several chunks
+      std::string longConcept(10000, 'x');
+      std::string list = "Indian\r\nWest Indian\n\n" + longConcept + "\nEast Asian\r\nTHAI\n";
+      for (size_t i = 0; list.size() < 3 * ConceptExtractor::BULK_CHUNK_SIZE; ++i) list += "concept " + std::to_string(i) + "\n";
+      list += "Sushi\nthai";
+
+      ConceptExtractor reference;
+      std::istringstream lines(list);
+      for (std::string line; std::getline(lines, line); ) {
+        if (line.size() > 0 && line[line.size() - 1] == '\r') line.resize(line.size() - 1);
+        reference.addConcept(line.c_str());
+      }
+
+      ThreadPool pool(4);
+      ConceptExtractor extractor;
+      extractor.addConcepts(View<char>(list.data(), list.size()), pool);
+
+      ASSERT_EQUAL(reference.conceptCount(), extractor.conceptCount());
+
+      size_t same = 0;
+      for (ConceptId id = 0; id < extractor.conceptCount(); ++id) same += (extractor.concept(id) == reference.concept(id));
+      ASSERT_EQUAL(extractor.conceptCount(), same);
+      ASSERT_EQUAL(String<>("thai"), String<>(extractor.concept(4)));
+
+      String<> input = "West Indian and East Asian concept 12345 with sushi";
+      auto concepts = extractor.get(input);
+      if (ASSERT_EQUAL(5UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("concept 12345", concepts[3]);
+      }
+
+      ASSERT_EQUAL(1UL, extractor.get(String<>(longConcept.c_str())).size());
+
+      // Streams skip no word as long as the longest concept
+      std::istringstream longText("with " + longConcept + " and more");
+      size_t count = 0;
+      extractor.stream(longText, [&count](const View<char>&) { ++count; }, 64);
+      ASSERT_EQUAL(1UL, count);
+
+      // The file constructor maps the list
+      const char* path = "TestConceptExtractor.txt";
+      std::ofstream(path, std::ios::binary) << list;
+      ConceptExtractor fileExtractor(path);
+      std::remove(path);
+
+      ASSERT_EQUAL(extractor.conceptCount(), fileExtractor.conceptCount());
+      ASSERT_EQUAL(1UL, fileExtractor.get(String<>(longConcept.c_str())).size());
+
+      // So do compiled dictionaries
+      const char* compiledPath = "TestConceptExtractor.s2c";
+      ASSERT_TRUE(extractor.compile(compiledPath));
+      ConceptExtractor compiledExtractor(compiledPath);
+      std::remove(compiledPath);
+
+      std::istringstream compiledText("with " + longConcept + " and more");
+      count = 0;
+      compiledExtractor.stream(compiledText, [&count](const View<char>&) { ++count; }, 64);
+      ASSERT_EQUAL(1UL, count);
+      ASSERT_EQUAL(5UL, fileExtractor.get(input).size());
+    }
+
+    {
+      // Test keyed word hashes: the same concepts are found, frozen or not
+      SeededConceptExtractor extractor { "West Indian", "East Asian Food", "Sushi" };
+      String<> input = "Which West Indian or East Asian food or sushi";
+
+      auto concepts = extractor.get(input);
+      if (ASSERT_EQUAL(3UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("East Asian Food", concepts[1]);
+        ASSERT_EQUAL("Sushi", concepts[2]);
+      }
+
+      extractor.freeze();
+      ASSERT_EQUAL(3UL, extractor.get(input).size());
+
+      // Hashes keyed per process cannot be compiled
+      ASSERT_TRUE(!extractor.compile("TestConceptExtractor.s2c"));
+    }
+
+    {
+      // Test another text policy: white space, quotes and brackets separate words
+      ExtendedConceptExtractor extractor { "West Indian", "East Asian Food", "Sushi" };
+      ConceptExtractor asciiExtractor { "West Indian", "East Asian Food", "Sushi" };
+
+      String<> input = "Which (West\tIndian) or \"East Asian\nfood\": [sushi]";
+      auto concepts = extractor.get(input);
+
+      if (ASSERT_EQUAL(3UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("East Asian Food", concepts[1]);
+        ASSERT_EQUAL("Sushi", concepts[2]);
+      }
+
+      ASSERT_EQUAL(0UL, asciiExtractor.get(input).size());
+
+      auto matches = extractor.matches(input);
+      if (ASSERT_EQUAL(3UL, matches.size())) {
+        ASSERT_EQUAL(7UL, matches[0].begin);
+        ASSERT_EQUAL(18UL, matches[0].end);
+      }
+    }
+
   }
 
 } //end namespace Concept
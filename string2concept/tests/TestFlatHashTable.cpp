@@ -0,0 +1,124 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <string>
+#include <utility>
+#include "../core/FlatHashTable.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "TestFlatHashTable.hpp"
+
+namespace Concept {
+
+  const char* TestFlatHashTable::name() const {
+    return "Checking Concept::FlatHashTable";
+  }
+
+  void TestFlatHashTable::operator()() {
+
+    {
+      // Test hash table keyed by size_t
+      FlatHashTable<size_t, Vector<char> > table;
+      Vector<char> value = String<>("BBQ");
+      table[128UL] = value;
+      ASSERT_EQUAL(value, table[128UL]);
+      ASSERT_EQUAL(1024UL, table.bucketCount());
+    }
+
+    // Test hash table keyed by Vector<char>, starting with a single group
+    using Table = FlatHashTable<Vector<char>, Vector<char>, 2>;
+    Table table;
+
+    ASSERT_EQUAL(16UL, table.bucketCount());
+
+    {
+      Vector<char> key = String<>("Indian");
+      table[key] = key;
+      ASSERT_EQUAL(key, table[key]);
+    }
+
+    ASSERT_EQUAL(1UL, table.size());
+
+    {
+      Vector<char> key = String<>("Sushi");
+      Vector<char> value = String<>("Where can I find good sushi");
+      table[key] = value;
+      ASSERT_EQUAL(value, table.find(key)->second);
+      ASSERT_EQUAL(key, table.find(Vector<char>(String<>("Sushi")))->first);
+      ASSERT_TRUE(table.end() == table.find(Vector<char>(String<>("sushi"))));
+    }
+
+    {
+      // Test lookups by view and with a precomputed hash
+      const char* text = "Where can I find good Sushi";
+      View<char> key(text + 22, 5);
+      ASSERT_EQUAL(Vector<char>(String<>("Sushi")), table.find(key)->first);
+      ASSERT_EQUAL(Vector<char>(String<>("Sushi")), table.find(key, Hash<Vector<char> >()(key))->first);
+      ASSERT_TRUE(table.end() == table.find(View<char>(text + 6, 3)));
+    }
+
+    {
+      // Grow beyond the load factor threshold: entries are moved to the new slots
+      for (size_t i = 0; i < 100; ++i) {
+        String<> key = "Concept number ";
+        key += std::to_string(i).c_str();
+        table[Vector<char>(key)] = Vector<char>(key);
+      }
+
+      ASSERT_EQUAL(102UL, table.size());
+      ASSERT_EQUAL(128UL, table.bucketCount());
+      ASSERT_TRUE(table.loadFactor() <= Table::LOAD_FACTOR_REHASH_THRESHOLD);
+
+      size_t found = 0;
+      for (size_t i = 0; i < 100; ++i) {
+        String<> key = "Concept number ";
+        key += std::to_string(i).c_str();
+        Vector<char> keyVector(key);
+        auto entry = table.find(keyVector);
+        if (entry != table.end() && entry->second == keyVector) ++found;
+      }
+
+      ASSERT_EQUAL(100UL, found);
+      ASSERT_EQUAL(Vector<char>(String<>("Where can I find good sushi")),
+                   table.find(Vector<char>(String<>("Sushi")))->second);
+    }
+
+    {
+      // Test explicit rehash: the slot count is rounded up to a power of two
+      table.rehash(1000);
+      ASSERT_EQUAL(1024UL, table.bucketCount());
+      ASSERT_EQUAL(102UL, table.size());
+      ASSERT_EQUAL(Vector<char>(String<>("Indian")), table.find(Vector<char>(String<>("Indian")))->second);
+    }
+  }
+
+} //end namespace Concept
@@ -59,6 +59,85 @@ namespace Concept {
       ASSERT_EQUAL(static_cast<size_t>(130654201U), FowlerNollVoHash()(str, strlen(str)));
       ASSERT_EQUAL(static_cast<size_t>(130654201U), Hash<Vector<char> >()(Vector<char>(str, strlen(str), false))); // No copy
     }
+
+    {
+      // Test that word hashes compose into the hash of a sequence of words
+      using WordHash = RollingWordHash<>;
+      const char* words = "east asian food";
+
+      size_t east  = WordHash::combine(0, WordHash::word(words, 4));
+      size_t asian = WordHash::combine(east, WordHash::word(words + 5, 5));
+      size_t food  = WordHash::combine(asian, WordHash::word(words + 11, 4));
+
+      ASSERT_EQUAL(FowlerNollVoHash()(words, 4), east);
+      ASSERT_EQUAL(food, WordHash()(words, strlen(words)));
+      ASSERT_EQUAL(food, (Hash<Vector<char>, WordHash>()(Vector<char>(words, strlen(words), false))));
+
+      // Runs of separators do not contribute
+      ASSERT_EQUAL(food, WordHash()(" east  asian food ", 18));
+
+      // Derive the hash of a span from prefix hashes
+      size_t base = WordHash::BASE;
+      ASSERT_EQUAL(WordHash()("asian food", 10), WordHash::span(east, food, base * base));
+      ASSERT_EQUAL(WordHash()("asian", 5), WordHash::span(east, asian, base));
+    }
+
+    {
+      // Test the SipHash-2-4 reference vectors, key 00 01 ... 0f and messages 00 01 ... of 0 and 15 bytes
+      char message[15];
+      for (int i = 0; i < 15; ++i) message[i] = static_cast<char>(i);
+
+      if (sizeof(size_t) == 8) {
+        SipHash<2, 4> reference(0x0706050403020100ULL, 0x0F0E0D0C0B0A0908ULL);
+        ASSERT_EQUAL(static_cast<size_t>(0x726FDB47DD0E0E31ULL), reference(message, 0));
+        ASSERT_EQUAL(static_cast<size_t>(0xA129CA6149BE45E5ULL), reference(message, 15));
+      }
+
+      // SipHash-1-3 depends on its key. Default functors share the key of the process
+      const char* str = "West indian";
+      ASSERT_TRUE(SipHash13(1, 2)(str, strlen(str)) == SipHash13(1, 2)(str, strlen(str)));
+      ASSERT_TRUE(SipHash13(1, 2)(str, strlen(str)) != SipHash13(1, 3)(str, strlen(str)));
+      ASSERT_TRUE(SipHash13(1, 2)(str, strlen(str)) != SipHash13(1, 2)(str, strlen(str) - 1));
+      ASSERT_TRUE(SipHash13()(str, strlen(str)) == SipHash13()(str, strlen(str)));
+      ASSERT_TRUE(SipHash13::processKey().key0 != 0 || SipHash13::processKey().key1 != 0);
+    }
+
+    {
+      // Test the CRC32C check value, and that hardware and software checksums agree
+      ASSERT_EQUAL(0xE3069283U, Crc32cHash::checksum("123456789", 9));
+      ASSERT_EQUAL(0xE3069283U, Crc32cHash::softwareChecksum("123456789", 9));
+      ASSERT_EQUAL(0U, Crc32cHash::checksum("", 0));
+
+      const char* text = "Which restaurants do East Asian food near the west indian ocean";
+      size_t mismatches = 0;
+      for (size_t i = 0; i <= strlen(text); ++i) {
+        mismatches += (Crc32cHash::checksum(text, i) != Crc32cHash::softwareChecksum(text, i));
+      }
+      ASSERT_EQUAL(0UL, mismatches);
+      ASSERT_EQUAL(Crc32cHash()(text, 10), (Hash<View<char>, Crc32cHash>()(View<char>(text, 10))));
+    }
+
+    {
+      // Test that the 8-bytes-at-a-time hash depends on every byte and on the length, for every length path
+      const char* text = "Which restaurants do East Asian food near the west indian ocean";
+      char copy[64];
+      size_t collisions = 0;
+
+      for (size_t len = 1; len <= strlen(text); ++len) {
+        memcpy(copy, text, len);
+        size_t hash = WyHash()(copy, len);
+
+        collisions += (hash == WyHash()(text, len - 1));
+        for (size_t i = 0; i < len; ++i) {
+          copy[i] ^= 1;
+          collisions += (hash == WyHash()(copy, len));
+          copy[i] ^= 1;
+        }
+        collisions += (hash != WyHash()(copy, len));
+      }
+      ASSERT_EQUAL(0UL, collisions);
+      ASSERT_EQUAL(WyHash()(text, 20), (Hash<Vector<char>, WyHash>()(Vector<char>(text, 20, false))));
+    }
   }
 
 } //end namespace Concept
@@ -38,6 +38,31 @@
 
 namespace Concept {
 
+  namespace {
+    /**
+    * Hash counting its calls, so that keys hashing to the same bucket differ by their hash
+    */
+    struct CountingHash {
+      size_t operator()(size_t key) const {
+        ++calls;
+        return key * 1543;
+      }
+
+      static size_t calls;
+    };
+
+    size_t CountingHash::calls = 0;
+
+    /**
+    * Hash sending every key to the same bucket
+    */
+    struct ConstantHash {
+      size_t operator()(size_t) const {
+        return 7;
+      }
+    };
+  }
+
   const char* TestHashTable::name() const {
     return "Checking Concept::HashTable";
   }
@@ -77,7 +102,7 @@ namespace Concept {
       ASSERT_EQUAL(key, table[key]);
     }
 
-    ASSERT_EQUAL(4, table.bucketCount());
+    ASSERT_EQUAL(5, table.bucketCount());
     ASSERT_EQUAL(2, table.size());
 
     {
@@ -86,7 +111,7 @@ namespace Concept {
       ASSERT_EQUAL(key, table[key]);
    }
 
-    ASSERT_EQUAL(4, table.bucketCount());
+    ASSERT_EQUAL(5, table.bucketCount());
     ASSERT_EQUAL(3, table.size());
 
     {
@@ -95,7 +120,7 @@ namespace Concept {
       ASSERT_EQUAL(key, table[key]);
     }
 
-    ASSERT_EQUAL(8, table.bucketCount());
+    ASSERT_EQUAL(11, table.bucketCount());
     ASSERT_EQUAL(4, table.size());
 
     {
@@ -107,8 +132,155 @@ namespace Concept {
       ASSERT_TRUE(table.end() == table.find(Vector<char>(String<>("sushi"))));
     }
 
-    ASSERT_EQUAL(8, table.bucketCount());
+    {
+      // Test lookup with a precomputed hash
+      Vector<char> key = String<>("Sushi");
+      size_t hash = Hash<Vector<char> >()(key);
+      ASSERT_EQUAL(key, table.find(key, hash)->first);
+      ASSERT_TRUE(table.end() == table.find(Vector<char>(String<>("Thai")), hash));
+    }
+
+    {
+      // Test heterogeneous lookup by a view, without building a key
+      const char* text = "Where can I find good Sushi";
+      View<char> key(text + 22, 5);
+      ASSERT_EQUAL(Vector<char>(String<>("Sushi")), table.find(key)->first);
+      ASSERT_EQUAL(Vector<char>(String<>("Sushi")), table.find(key, Hash<Vector<char> >()(key))->first);
+      ASSERT_TRUE(table.end() == table.find(View<char>(text + 6, 3)));
+    }
+
+    ASSERT_EQUAL(11, table.bucketCount());
     ASSERT_EQUAL(5, table.size());
+
+    {
+      // Test incremental growth: every entry stays reachable while buckets migrate
+      HashTable<size_t, size_t, 64> numbers;
+      size_t growths = 0;
+      size_t reachable = 0;
+      size_t insertions = 0;
+
+      for (size_t i = 0; i < 10000; ++i) {
+        size_t bucketCount = numbers.bucketCount();
+        bool migrating = numbers.migrating();
+
+        numbers[i] = 2 * i;
+
+        // A migration ends before the next growth
+        if (numbers.bucketCount() != bucketCount) {
+          ++growths;
+          insertions += !migrating;
+        }
+
+        if (numbers.migrating() && i % 97 == 0) {
+          size_t found = 0;
+          for (size_t j = 0; j <= i; ++j) found += (numbers.find(j) != numbers.end() && numbers.find(j)->second == 2 * j);
+          reachable += (found == i + 1);
+        }
+      }
+
+      ASSERT_TRUE(growths > 5);
+      ASSERT_EQUAL(growths, insertions);
+      ASSERT_TRUE(reachable > 0);
+
+      size_t count = 0;
+      numbers.forEach([&count](const std::pair<size_t, size_t>&) { ++count; });
+      ASSERT_EQUAL(10000UL, count);
+
+      // rehash() ends the migration at once
+      numbers.rehash(2 * numbers.bucketCount());
+      ASSERT_TRUE(!numbers.migrating());
+      ASSERT_EQUAL(10000UL, numbers.size());
+      ASSERT_EQUAL(9999UL * 2, numbers.find(9999UL)->second);
+    }
+
+    {
+      // Test cached hashes: keys are hashed once on insertion, never on growth
+      HashTable<size_t, size_t, 2, CountingHash> numbers;
+      for (size_t i = 0; i < 1000; ++i) numbers[i] = i;
+
+      ASSERT_EQUAL(1000UL, CountingHash::calls);
+      ASSERT_TRUE(numbers.bucketCount() > 1000);
+
+      numbers.rehash(4 * numbers.bucketCount());
+      ASSERT_EQUAL(1000UL, CountingHash::calls);
+
+      // All keys share the bucket 0 of 1543 buckets, they are told apart by their hashes
+      HashTable<size_t, size_t, 1543, CountingHash> colliding;
+      ASSERT_EQUAL(1543, colliding.bucketCount());
+      for (size_t i = 0; i < 100; ++i) colliding[i] = i;
+
+      size_t found = 0;
+      for (size_t i = 0; i < 100; ++i) found += (colliding.find(i)->second == i);
+      ASSERT_EQUAL(100UL, found);
+      ASSERT_TRUE(colliding.end() == colliding.find(100UL));
+
+      // Their chain was converted to a sorted bucket
+      ASSERT_EQUAL(1UL, colliding.sortedBucketCount());
+    }
+
+    {
+      // Test sorted buckets through growths and full hash collisions
+      HashTable<size_t, size_t, 2, ConstantHash> constant;
+      for (size_t i = 0; i < 1000; ++i) constant[i] = i + 1;
+
+      size_t found = 0;
+      for (size_t i = 0; i < 1000; ++i) found += (constant.find(i)->second == i + 1);
+      ASSERT_EQUAL(1000UL, found);
+      ASSERT_EQUAL(1UL, constant.sortedBucketCount());
+      ASSERT_TRUE(constant.end() == constant.find(1000UL));
+
+      size_t sum = 0;
+      constant.forEach([&sum](const std::pair<size_t, size_t>& entry) { sum += entry.second; });
+      ASSERT_EQUAL(500500UL, sum);
+
+      // Entries in short chains are not sorted
+      HashTable<size_t, size_t> numbers;
+      for (size_t i = 0; i < 1000; ++i) numbers[i] = i;
+      ASSERT_EQUAL(0UL, numbers.sortedBucketCount());
+    }
+
+    {
+      // Test the prime growth policy: fastmod matches the modulo of the folded hash
+      PrimeGrowthPolicy policy(1000);
+      ASSERT_EQUAL(1543, policy.bucketCount());
+      ASSERT_EQUAL(3079, policy.grown().bucketCount());
+      ASSERT_EQUAL(2, PrimeGrowthPolicy().bucketCount());
+
+      size_t mismatches = 0;
+      for (PrimeGrowthPolicy p; p.bucketCount() < 100000000; p = p.grown()) {
+        for (uint64_t i = 0; i < 1000; ++i) {
+          size_t hash = static_cast<size_t>(i * UINT64_C(0x9E3779B97F4A7C15));
+          uint32_t folded = static_cast<uint32_t>(static_cast<uint64_t>(hash) ^ (static_cast<uint64_t>(hash) >> 32));
+          mismatches += (p.bucket(hash) != folded % p.bucketCount());
+        }
+        mismatches += (p.bucket(~size_t(0)) >= p.bucketCount());
+      }
+      ASSERT_EQUAL(0UL, mismatches);
+    }
+
+    {
+      // Test the power of two growth policy, and a table using it
+      PowerOfTwoGrowthPolicy policy(1000);
+      ASSERT_EQUAL(1024, policy.bucketCount());
+      ASSERT_EQUAL(2048, policy.grown().bucketCount());
+      ASSERT_EQUAL(2, PowerOfTwoGrowthPolicy().bucketCount());
+
+      // Multiples of the bucket count still spread over the buckets
+      bool used[1024] = {};
+      for (size_t i = 0; i < 1024; ++i) used[policy.bucket(i * 1024)] = true;
+      size_t usedCount = 0;
+      for (size_t i = 0; i < 1024; ++i) usedCount += used[i];
+      ASSERT_TRUE(usedCount > 512);
+
+      HashTable<size_t, size_t, 2, Hash<size_t>, PowerOfTwoGrowthPolicy> numbers;
+      for (size_t i = 0; i < 10000; ++i) numbers[i] = 3 * i;
+
+      size_t found = 0;
+      for (size_t i = 0; i < 10000; ++i) found += (numbers.find(i)->second == 3 * i);
+      ASSERT_EQUAL(10000UL, found);
+      ASSERT_EQUAL(0UL, numbers.bucketCount() & (numbers.bucketCount() - 1));
+      ASSERT_TRUE(numbers.end() == numbers.find(10000UL));
+    }
   }
 
 } //end namespace Concept
@@ -0,0 +1,144 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include "../ConceptExtractor.hpp"
+#include "../NGramConceptExtractor.hpp"
+#include "../core/String.hpp"
+#include "../core/View.hpp"
+#include "TestNGramConceptExtractor.hpp"
+
+namespace Concept {
+
+  const char* TestNGramConceptExtractor::name() const {
+    return "Checking Concept::NGramConceptExtractor";
+  }
+
+  void TestNGramConceptExtractor::operator()() {
+
+    {
+      // Test concept extraction
+      NGramConceptExtractor extractor {
+        "Indian",
+        "West Indian",
+        "East Asian",
+        "East Asian Food",
+        "Asian Food Market",
+        "Food"
+      };
+
+      // Dictionary words are interned once
+      ASSERT_EQUAL(6UL, extractor.conceptCount());
+      ASSERT_EQUAL(6UL, extractor.vocabularySize());
+
+      String<> input = "Which restaurants do West Indian or East Asian food?";
+      auto concepts = extractor.get(input);
+
+      if (ASSERT_EQUAL(5UL, concepts.size())) {
+        ASSERT_EQUAL("West Indian", concepts[0]);
+        ASSERT_EQUAL("Indian", concepts[1]);
+        ASSERT_EQUAL("East Asian", concepts[2]);
+        ASSERT_EQUAL("East Asian Food", concepts[3]);
+        ASSERT_EQUAL("Food", concepts[4]);
+      }
+
+      // Unknown words end candidates
+      ASSERT_EQUAL(1UL, extractor.get(String<>("asian food oriental market")).size());
+      ASSERT_EQUAL(0UL, extractor.get(String<>("")).size());
+      ASSERT_EQUAL(0UL, extractor.get(String<>("nothing to find here")).size());
+
+      // A concept added again in another case keeps its ID
+      extractor.addConcept("EAST ASIAN");
+      ASSERT_EQUAL(6UL, extractor.conceptCount());
+      ASSERT_EQUAL(String<>("EAST ASIAN"), String<>(extractor.concept(2)));
+    }
+
+    {
+      // Test match positions against the hashed extractor
+      const char* concepts[] = { "Indian", "West Indian", "East Asian", "East Asian Food", "Thai" };
+      NGramConceptExtractor extractor;
+      ConceptExtractor reference;
+      for (auto concept : concepts) {
+        extractor.addConcept(concept);
+        reference.addConcept(concept);
+      }
+
+      String<> input = "  Which restaurants do West Indian, or East   Asian food? thai";
+      auto matches = extractor.matches(input);
+      auto expected = reference.matches(input);
+
+      size_t identical = 0;
+      for (size_t i = 0; i < matches.size() && i < expected.size(); ++i) {
+        identical += (matches[i].begin == expected[i].begin && matches[i].end == expected[i].end &&
+                      matches[i].wordIndex == expected[i].wordIndex && matches[i].conceptId == expected[i].conceptId);
+      }
+
+      ASSERT_EQUAL(5UL, matches.size());
+      ASSERT_EQUAL(5UL, identical);
+    }
+
+    {
+      // Test many concepts, growing the n-gram table
+      NGramConceptExtractor extractor;
+      for (size_t i = 0; i < 5000; ++i) {
+        String<> concept = "concept number ";
+        concept += std::to_string(i).c_str();
+        extractor.addConcept(concept.c_str());
+      }
+
+      ASSERT_EQUAL(5000UL, extractor.conceptCount());
+      ASSERT_EQUAL(5002UL, extractor.vocabularySize());
+
+      auto concepts = extractor.get(String<>("find concept number 4321 and concept number 12 or concept 7"));
+      if (ASSERT_EQUAL(2UL, concepts.size())) {
+        ASSERT_EQUAL("concept number 4321", concepts[0]);
+        ASSERT_EQUAL("concept number 12", concepts[1]);
+      }
+    }
+
+    {
+      // Test a concept list file: lines of any length, CRLF line breaks
+      std::string longConcept(2000, 'x');
+      const char* path = "TestNGramConceptExtractor.txt";
+      std::ofstream(path, std::ios::binary) << "Indian\r\n" << longConcept << "\nEast Asian\r\nSushi\n";
+      NGramConceptExtractor extractor(path);
+      std::remove(path);
+
+      ASSERT_EQUAL(4UL, extractor.conceptCount());
+      ASSERT_EQUAL(3UL, extractor.get(String<>("Indian or East Asian sushi")).size());
+      ASSERT_EQUAL(1UL, extractor.get(String<>(longConcept.c_str())).size());
+    }
+  }
+
+} //end namespace Concept
@@ -0,0 +1,179 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <cstdlib>
+#include "../core/Vector.hpp"
+#include "../Normalizer.hpp"
+#include "../TextPolicy.hpp"
+#include "../Words.hpp"
+#include "TestNormalizer.hpp"
+
+namespace Concept {
+
+  namespace {
+    /**
+    * Rules folding to uppercase, which vector kernels do not support
+    */
+    struct UpperCaseRules : AsciiTextRules {
+      static constexpr unsigned char fold(unsigned char ch) {
+        return (ch >= 'a' && ch <= 'z') ? static_cast<unsigned char>(ch - ('a' - 'A')) : ch;
+      }
+    };
+
+    static_assert(TextTables::classify<AsciiTextRules>(' ') == SEPARATOR, "space separates words");
+    static_assert(TextTables::classify<ExtendedTextRules>('\t') == SEPARATOR, "tabulation separates words");
+    static_assert(TextTables::classify<ExtendedTextRules>(':') == PUNCTUATION, "colon is punctuation");
+
+    /**
+    * Normalize as the former two-pass implementation did: fold, then remove characters
+    */
+    template <typename Policy>
+    void referenceNormalize(Vector<char>& text, Vector<uint32_t>& positions) {
+      positions.resize(text.size());
+
+      Vector<char> original(text);
+      for (auto& c : text) c = Policy::isSeparator(c) ? ' ' : Policy::fold(c);
+
+      size_t offset = 0;
+      for (auto it = original.begin(); it != original.end(); ++it) {
+        if (Policy::isPunctuation(*it) ||
+            (Policy::isSeparator(*it) && (it == original.begin() || (it + 1) == original.end() ||
+                                          Policy::isPunctuation(*(it + 1)) || Policy::isSeparator(*(it + 1))))) {
+          ++offset;
+          continue;
+        }
+
+        size_t i = it - original.begin();
+        positions[i - offset] = static_cast<uint32_t>(i);
+        text[i - offset] = text[i];
+      }
+
+      text.resize(text.size() - offset);
+      positions.resize(text.size());
+    }
+
+    /**
+    * @return the word boundaries found by Words
+    */
+    template <typename Policy>
+    Vector<uint32_t> referenceBoundaries(const Vector<char>& text) {
+      BasicWords<Policy> words(text, false);
+
+      Vector<uint32_t> boundaries;
+      for (auto& word : words) {
+        boundaries.push_back(static_cast<uint32_t>(word.begin() - text.begin()));
+        boundaries.push_back(static_cast<uint32_t>(word.end() - text.begin()));
+      }
+
+      return boundaries;
+    }
+  }
+
+  const char* TestNormalizer::name() const {
+    return "Checking Concept::Normalizer";
+  }
+
+  void TestNormalizer::operator()() {
+
+    {
+      // Test normalization
+      Vector<char> text("  Which Restaurants, do East  Asian food?! ", 43);
+      Normalizer::normalize(text, nullptr, nullptr, Normalizer::SCALAR);
+      ASSERT_EQUAL(Vector<char>(" which restaurants do east asian food", 37), text);
+      ASSERT_TRUE(Normalizer::supports(Normalizer::SCALAR));
+      ASSERT_TRUE(Normalizer::supports(Normalizer::bestKernel()));
+    }
+
+    {
+      // Test other text policies
+      Vector<char> text("(West) Indian:\t\"East\"\n", 22);
+      Vector<uint32_t> boundaries;
+      BasicNormalizer<ExtendedTextPolicy>::normalize(text, nullptr, &boundaries);
+      ASSERT_EQUAL(Vector<char>("west indian east", 16), text);
+      ASSERT_EQUAL(6UL, boundaries.size());
+
+      // Policies folding other than ASCII lowercase run the scalar kernel
+      ASSERT_TRUE(BasicNormalizer<ExtendedTextPolicy>::supports(BasicNormalizer<ExtendedTextPolicy>::SSE42) ==
+                  Normalizer::supports(Normalizer::SSE42));
+      ASSERT_TRUE(!BasicNormalizer<TextPolicy<UpperCaseRules> >::supports(BasicNormalizer<TextPolicy<UpperCaseRules> >::SSE42));
+
+      text = Vector<char>("West, Indian", 12);
+      BasicNormalizer<TextPolicy<UpperCaseRules> >::normalize(text);
+      ASSERT_EQUAL(Vector<char>("WEST INDIAN", 11), text);
+    }
+
+    ASSERT_EQUAL(0UL, differentKernels<DefaultTextPolicy>());
+    ASSERT_EQUAL(0UL, differentKernels<ExtendedTextPolicy>());
+    ASSERT_EQUAL(0UL, differentKernels<TextPolicy<UpperCaseRules> >());
+  }
+
+  /**
+  * Every kernel supported by the CPU must match the former implementation, on texts of all lengths
+  * @return the number of texts normalized differently
+  */
+  template <typename Policy>
+  size_t TestNormalizer::differentKernels() {
+    using Normalizer = BasicNormalizer<Policy>;
+
+    const typename Normalizer::Kernel kernels[] = { Normalizer::SCALAR, Normalizer::SSE42, Normalizer::AVX2 };
+    const char alphabet[] = { 'a', 'b', 'Q', 'Z', 'z', '@', '[', '`', ' ', ' ', ' ', ',', ';', '.', '!', '?', '\0', '\n',
+                              '\t', '(', '"', '\xC3', '\xA9' };
+
+    size_t different = 0;
+
+    for (auto kernel : kernels) {
+      if (!Normalizer::supports(kernel)) continue;
+
+      srand(7);
+
+      for (size_t length = 0; length < 300; ++length) {
+        for (size_t trial = 0; trial < 8; ++trial) {
+          Vector<char> text;
+          for (size_t i = 0; i < length; ++i) text.push_back(alphabet[rand() % sizeof(alphabet)]);
+
+          Vector<char> expected(text);
+          Vector<uint32_t> expectedPositions;
+          referenceNormalize<Policy>(expected, expectedPositions);
+
+          Vector<uint32_t> positions, boundaries;
+          Normalizer::normalize(text, &positions, &boundaries, kernel);
+
+          different += !(text == expected && positions == expectedPositions &&
+                         boundaries == referenceBoundaries<Policy>(expected));
+        }
+      }
+    }
+
+    return different;
+  }
+
+} //end namespace Concept
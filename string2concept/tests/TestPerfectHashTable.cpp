@@ -0,0 +1,122 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <string>
+#include <utility>
+#include "../core/FlatHashTable.hpp"
+#include "../core/HashTable.hpp"
+#include "../core/PerfectHashTable.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "TestPerfectHashTable.hpp"
+
+namespace Concept {
+
+  const char* TestPerfectHashTable::name() const {
+    return "Checking Concept::PerfectHashTable";
+  }
+
+  void TestPerfectHashTable::operator()() {
+
+    {
+      // Test an empty table
+      PerfectHashTable<Vector<char>, size_t> table;
+      HashTable<Vector<char>, size_t> source;
+
+      ASSERT_TRUE(table.build(source));
+      ASSERT_EQUAL(0UL, table.size());
+      ASSERT_TRUE(table.end() == table.find(Vector<char>(String<>("Thai"))));
+    }
+
+    {
+      // Build from a chained Hash table
+      HashTable<Vector<char>, size_t> source;
+      for (size_t i = 0; i < 10000; ++i) {
+        String<> key = "Concept number ";
+        key += std::to_string(i).c_str();
+        source[Vector<char>(key)] = i;
+      }
+
+      PerfectHashTable<Vector<char>, size_t> table;
+      ASSERT_TRUE(table.build(source));
+      ASSERT_EQUAL(10000UL, table.size());
+      ASSERT_EQUAL(2001UL, table.bucketCount());
+      ASSERT_TRUE(table.bitsPerKey() < 8.1);
+
+      // Every key is found at its value, missing keys are rejected
+      size_t found = 0;
+      size_t missing = 0;
+      for (size_t i = 0; i < 10000; ++i) {
+        String<> key = "Concept number ";
+        key += std::to_string(i).c_str();
+        Vector<char> keyVector(key);
+        auto entry = table.find(keyVector);
+        if (entry != table.end() && entry->second == i) ++found;
+
+        key += "!";
+        if (table.find(Vector<char>(key)) == table.end()) ++missing;
+      }
+
+      ASSERT_EQUAL(10000UL, found);
+      ASSERT_EQUAL(10000UL, missing);
+
+      // Lookup by view with a precomputed hash
+      const char* text = "Concept number 42";
+      View<char> view(text, strlen(text));
+      ASSERT_EQUAL(42UL, table.find(view, Hash<Vector<char> >()(view))->second);
+
+      size_t sum = 0;
+      table.forEach([&sum](std::pair<Vector<char>, size_t>& entry) { sum += entry.second; });
+      ASSERT_EQUAL(49995000UL, sum);
+
+      table.clear();
+      ASSERT_EQUAL(0UL, table.size());
+      ASSERT_TRUE(table.end() == table.find(view));
+    }
+
+    {
+      // Build from an open-addressing Hash table
+      FlatHashTable<Vector<char>, Vector<char> > source;
+      const char* concepts[] = { "Indian", "Thai", "Sushi", "East Asian", "West Indian" };
+      for (auto concept : concepts) source[Vector<char>(concept, strlen(concept))] = Vector<char>(concept, strlen(concept));
+
+      PerfectHashTable<Vector<char>, Vector<char> > table;
+      ASSERT_TRUE(table.build(source));
+      ASSERT_EQUAL(5UL, table.size());
+
+      Vector<char> key = String<>("East Asian");
+      ASSERT_EQUAL(key, table.find(key)->second);
+      ASSERT_TRUE(table.end() == table.find(Vector<char>(String<>("east asian"))));
+    }
+  }
+
+} //end namespace Concept
@@ -47,7 +47,8 @@ namespace Concept {
     // Test Short String Construction
     String<20> str1("I would");
 
-    ASSERT_EQUAL(20ULL, str1.capacity());
+    // Small strings fill the object
+    ASSERT_EQUAL(3 * sizeof(void*) - 1, str1.capacity());
 
     ASSERT_EQUAL("I would", str1);
 
@@ -69,7 +70,7 @@ namespace Concept {
 
     String<10> str2("Where");
 
-    ASSERT_EQUAL(10ULL, str2.capacity());
+    ASSERT_EQUAL(3 * sizeof(void*) - 1, str2.capacity());
 
     ASSERT_EQUAL("Where", str2);
 
@@ -78,6 +79,54 @@ namespace Concept {
 
     // Test non-member equality operator and move constructor
     ASSERT_EQUAL("Where can I find good sushi", str2 + String<>(" can I find good sushi"));
+
+    // Test the compact layout
+    ASSERT_EQUAL(3 * sizeof(void*), sizeof(String<>));
+    ASSERT_EQUAL(3 * sizeof(void*), sizeof(String<8>));
+    ASSERT_EQUAL(47ULL, String<40>().capacity());
+
+    // Small buffers are clamped, then longer strings go to the heap
+    ASSERT_EQUAL(128ULL, sizeof(String<500>));
+    String<> piece("Which restaurants do East Asian food");
+    String<500> large(piece.c_str());
+    ASSERT_EQUAL(127ULL, large.capacity());
+    for (size_t i = 1; i < 32; ++i) large += piece;
+    ASSERT_EQUAL(36ULL * 32, large.length());
+    ASSERT_TRUE(strncmp(large.c_str() + 36 * 31, "Which restaurants do East Asian food", 36) == 0);
+
+    // A full small string ends with its remaining space, thus zero
+    const char* full = "abcdefghijklmnopqrstuvw";
+    String<> str3(full);
+    ASSERT_EQUAL(sizeof(void*) == 8 ? 23ULL : strlen(full), str3.length());
+    ASSERT_EQUAL(full, str3);
+    ASSERT_EQUAL(0, str3.c_str()[str3.length()]);
+
+    // Growing past the small buffer
+    str3 += "x";
+    ASSERT_EQUAL("abcdefghijklmnopqrstuvwx", str3);
+    ASSERT_EQUAL(24ULL, str3.length());
+    ASSERT_EQUAL(24ULL, str3.capacity());
+
+    // Moving transfers the heap buffer and empties the source
+    String<> str4(std::move(str3));
+    ASSERT_EQUAL("abcdefghijklmnopqrstuvwx", str4);
+    ASSERT_EQUAL(0ULL, str3.length());
+    ASSERT_EQUAL(3 * sizeof(void*) - 1, str3.capacity());
+    ASSERT_EQUAL("", str3);
+
+    // Shrinking keeps the heap buffer
+    str4 = "Thai";
+    ASSERT_EQUAL("Thai", str4);
+    ASSERT_EQUAL(4ULL, str4.length());
+    ASSERT_EQUAL(24ULL, str4.capacity());
+
+    // Large small strings
+    String<40> str5("Which restaurants do East Asian food");
+    ASSERT_EQUAL(36ULL, str5.length());
+    ASSERT_EQUAL(47ULL, str5.capacity());
+    str5 += " or West Indian";
+    ASSERT_EQUAL("Which restaurants do East Asian food or West Indian", str5);
+    ASSERT_EQUAL(String<>("Which restaurants do East Asian food or West Indian"), String<40>(std::move(str5)));
   }
 
 } //end namespace Concept
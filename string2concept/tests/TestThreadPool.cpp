@@ -0,0 +1,87 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <atomic>
+#include "../core/ThreadPool.hpp"
+#include "../core/Vector.hpp"
+#include "TestThreadPool.hpp"
+
+namespace Concept {
+
+  const char* TestThreadPool::name() const {
+    return "Checking Concept::ThreadPool";
+  }
+
+  void TestThreadPool::operator()() {
+
+    {
+      // A single thread pool runs the tasks in the caller
+      ThreadPool pool(1);
+      ASSERT_EQUAL(1UL, pool.size());
+
+      size_t sum = 0;
+      pool.run(100, [&sum](size_t i) { sum += i; });
+      ASSERT_EQUAL(4950UL, sum);
+    }
+
+    {
+      // Every task runs exactly once, over several runs
+      ThreadPool pool(4);
+      ASSERT_EQUAL(4UL, pool.size());
+
+      Vector<size_t> counts;
+      counts.resize(10000);
+      for (auto& count : counts) count = 0;
+
+      for (size_t run = 0; run < 3; ++run) {
+        pool.run(counts.size(), [&counts](size_t i) { ++counts[i]; });
+      }
+
+      size_t exact = 0;
+      for (auto& count : counts) exact += (count == 3);
+      ASSERT_EQUAL(10000UL, exact);
+
+      // Fewer tasks than threads, then none
+      std::atomic<size_t> sum(0);
+      pool.run(2, [&sum](size_t i) { sum += i + 1; });
+      pool.run(0, [&sum](size_t i) { sum += 100; });
+      ASSERT_EQUAL(3UL, sum.load());
+    }
+
+    {
+      // Zero threads means one per hardware thread
+      ThreadPool pool;
+      ASSERT_TRUE(pool.size() >= 1);
+    }
+  }
+
+} //end namespace Concept
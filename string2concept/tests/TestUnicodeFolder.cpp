@@ -0,0 +1,176 @@
+/**
+* @file
+* @author  Leonce Mekinda <https://sites.google.com/site/leoncemekinda/>
+*
+* @section LICENSE
+*
+* The MIT License
+*
+* Copyright(c) 2019 Leonce Mekinda
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files(the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE
+*
+* ==============================================================================
+*/
+#include "stdafx.h"
+
+#include <cstdlib>
+#include <cstring>
+#include "../ConceptExtractor.hpp"
+#include "../core/String.hpp"
+#include "../core/Vector.hpp"
+#include "../Normalizer.hpp"
+#include "../UnicodeFolder.hpp"
+#include "TestUnicodeFolder.hpp"
+
+namespace Concept {
+
+  namespace {
+    /**
+    * @return the folded text
+    */
+    Vector<char> folded(const char* text, UnicodeFolding folding) {
+      Vector<char> result(text, strlen(text));
+      UnicodeFolder::fold(result, folding);
+      return result;
+    }
+
+    /**
+    * @return the text as a Vector
+    */
+    Vector<char> vector(const char* text) {
+      return Vector<char>(text, strlen(text));
+    }
+  }
+
+  const char* TestUnicodeFolder::name() const {
+    return "Checking Concept::UnicodeFolder";
+  }
+
+  void TestUnicodeFolder::operator()() {
+
+    {
+      // Test case folding: ASCII is left to the text policy, and the final sigma is folded as any sigma
+      ASSERT_EQUAL(vector("Café üRüN éCOLE Straße"), folded("Café ÜRÜN ÉCOLE Straße", UNICODE_CASE_FOLDING));
+      ASSERT_EQUAL(vector("αθήνα μόσχα σοφόσ σοφόσ москва ёлка"), folded("ΑΘΉΝΑ ΜΌΣΧΑ ΣΟΦΌΣ σοφός МОСКВА Ёлка", UNICODE_CASE_FOLDING));
+      ASSERT_EQUAL(vector("ÜRÜN"), folded("ÜRÜN", NO_UNICODE_FOLDING));
+
+      // Test diacritic stripping
+      ASSERT_EQUAL(vector("Cafe urun eCOLE Strasse aesir naive"), folded("Café Ürün ÉCOLE Straße Æsir naïve", UNICODE_ACCENT_FOLDING));
+      ASSERT_EQUAL(vector("αθηνα елка"), folded("Αθήνα Ёлка", UNICODE_ACCENT_FOLDING));
+
+      // Combining marks go with diacritics
+      ASSERT_EQUAL(vector("cafe"), folded("cafe\xCC\x81", UNICODE_ACCENT_FOLDING));
+      ASSERT_EQUAL(vector("cafe\xCC\x81"), folded("cafe\xCC\x81", UNICODE_CASE_FOLDING));
+
+      // Other sequences and invalid bytes are kept
+      ASSERT_EQUAL(vector("10 \xE2\x82\xAC \xF0\x9F\x8D\xB5 \xC3"), folded("10 \xE2\x82\xAC \xF0\x9F\x8D\xB5 \xC3", UNICODE_ACCENT_FOLDING));
+      ASSERT_EQUAL(vector("\xA9 \xC3("), folded("\xA9 \xC3(", UNICODE_ACCENT_FOLDING));
+    }
+
+    {
+      // Test positions
+      Vector<char> text = vector("Æ É x");
+      Vector<uint32_t> positions;
+      UnicodeFolder::fold(text, UNICODE_ACCENT_FOLDING, &positions);
+
+      ASSERT_EQUAL(vector("ae e x"), text);
+      if (ASSERT_EQUAL(6UL, positions.size())) {
+        const uint32_t expected[] = { 0, 0, 2, 3, 5, 6 };
+        size_t identical = 0;
+        for (size_t i = 0; i < 6; ++i) identical += (positions[i] == expected[i]);
+        ASSERT_EQUAL(6UL, identical);
+      }
+    }
+
+    {
+      // Test long texts mixing ASCII blocks and shortened characters
+      struct Piece {
+        const char* text;
+        const char* folded;
+        bool        character; ///< true if the piece is one character folded, false if it is kept as is
+      };
+
+      const Piece pieces[] = {
+        { "Les ", "Les ", false }, { "É", "e", true }, { "æ", "ae", true }, { "Ü", "u", true }, { "ß", "ss", true },
+        { "e\xCC\x81", "e", true }, { "0123456789abcdefghijklmnopqrstuvwxyz ", "0123456789abcdefghijklmnopqrstuvwxyz ", false },
+        { "\xE2\x82\xAC", "\xE2\x82\xAC", false }
+      };
+
+      srand(11);
+      size_t different = 0;
+
+      for (size_t trial = 0; trial < 200; ++trial) {
+        Vector<char> text, expected;
+        Vector<uint32_t> expectedPositions;
+
+        for (size_t count = rand() % 40; count > 0; --count) {
+          const Piece& piece = pieces[rand() % (sizeof(pieces) / sizeof(pieces[0]))];
+          size_t offset = text.size();
+
+          text += vector(piece.text);
+          expected += vector(piece.folded);
+
+          // The bytes of a folded character all come from its first byte
+          for (size_t i = 0; i < strlen(piece.folded); ++i) {
+            expectedPositions.push_back(static_cast<uint32_t>(piece.character ? offset : offset + i));
+          }
+        }
+
+        Vector<uint32_t> positions;
+        UnicodeFolder::fold(text, UNICODE_ACCENT_FOLDING, &positions);
+
+        different += !(text == expected && positions == expectedPositions);
+      }
+
+      ASSERT_EQUAL(0UL, different);
+    }
+
+    {
+      // Test accent-insensitive extraction, reporting original offsets
+      AccentInsensitiveConceptExtractor extractor { "Café", "Ürün", "École Normale", "Αθήνα" };
+
+      String<> input = "Un CAFE a la ECOLE normale, urun! αθηνα";
+      auto concepts = extractor.get(input);
+
+      if (ASSERT_EQUAL(4UL, concepts.size())) {
+        ASSERT_EQUAL("Café", concepts[0]);
+        ASSERT_EQUAL("École Normale", concepts[1]);
+        ASSERT_EQUAL("Ürün", concepts[2]);
+        ASSERT_EQUAL("Αθήνα", concepts[3]);
+      }
+
+      String<> accented = "À votre École Normale";
+      auto matches = extractor.matches(accented);
+      if (ASSERT_EQUAL(1UL, matches.size())) {
+        ASSERT_EQUAL(9UL, matches[0].begin);
+        ASSERT_EQUAL(accented.length(), matches[0].end);
+      }
+
+      // Case folding only keeps diacritics
+      UnicodeConceptExtractor caseExtractor { "Café", "Ürün" };
+      ASSERT_EQUAL(2UL, caseExtractor.get(String<>("CAFÉ CAFE ÜRÜN")).size());
+
+      ConceptExtractor asciiExtractor { "Ürün" };
+      ASSERT_EQUAL(0UL, asciiExtractor.get(String<>("ürün")).size());
+      ASSERT_EQUAL(1UL, caseExtractor.get(String<>("ürün")).size());
+    }
+  }
+
+} //end namespace Concept
@@ -30,6 +30,8 @@
 */
 #include "stdafx.h"
 
+#include <memory>
+#include <stdexcept>
 #include <utility>
 #include "../core/String.hpp"
 #include "../core/Vector.hpp"
@@ -37,6 +39,56 @@
 
 namespace Concept {
 
+  namespace {
+    /**
+    * Element counting its constructions, copies, moves and destructions
+    */
+    struct Counted {
+      Counted() : value(0) { ++constructions; }
+      Counted(int value) : value(value) { ++constructions; }
+      Counted(const Counted& other) : value(other.value) { ++copies; }
+      Counted(Counted&& other) noexcept : value(other.value) { ++moves; }
+      ~Counted() { ++destructions; }
+
+      Counted& operator=(const Counted& other) { value = other.value; ++copies; return *this; }
+      Counted& operator=(Counted&& other) noexcept { value = other.value; ++moves; return *this; }
+
+      static void reset() { constructions = copies = moves = destructions = 0; }
+
+      int value;
+
+      static size_t constructions;
+      static size_t copies;
+      static size_t moves;
+      static size_t destructions;
+    };
+
+    size_t Counted::constructions = 0;
+    size_t Counted::copies = 0;
+    size_t Counted::moves = 0;
+    size_t Counted::destructions = 0;
+
+    /**
+    * Allocator counting its allocations
+    */
+    template <typename T>
+    struct CountingAllocator : std::allocator<T> {
+      template <typename U> struct rebind { using other = CountingAllocator<U>; };
+
+      CountingAllocator() {}
+      template <typename U> CountingAllocator(const CountingAllocator<U>&) {}
+
+      T* allocate(size_t n) { ++allocations; return std::allocator<T>::allocate(n); }
+      void deallocate(T* p, size_t n) { ++deallocations; std::allocator<T>::deallocate(p, n); }
+
+      static size_t allocations;
+      static size_t deallocations;
+    };
+
+    template <typename T> size_t CountingAllocator<T>::allocations = 0;
+    template <typename T> size_t CountingAllocator<T>::deallocations = 0;
+  }
+
   const char* TestVector::name() const {
     return "Checking Concept::Vector";
   }
@@ -65,6 +117,14 @@ namespace Concept {
       ASSERT_EQUAL(37ULL, buffer.capacity());
     }
 
+    {
+      // A heap-allocated String fitting the small buffer is copied into it
+      Vector<char, 256> buffer = String<>("Which restaurants do East Asian food");
+      ASSERT_EQUAL(256ULL, buffer.capacity());
+      ASSERT_EQUAL(36ULL, buffer.size());
+      ASSERT_TRUE(buffer == View<char>("Which restaurants do East Asian food", 36));
+    }
+
     {
       // Test vector of objects
       class Country {
@@ -116,6 +176,14 @@ namespace Concept {
       ASSERT_EQUAL(cstr, buffer3.data());
       ASSERT_EQUAL(cBufferSize, buffer3.capacity());
 
+      // Moving an owned heap buffer transfers its ownership
+      Vector<char> owned(String<>("Which restaurants do East Asian food"));
+      const char* ownedData = owned.data();
+      Vector<char> moved(std::move(owned));
+      ASSERT_EQUAL(ownedData, moved.data());
+      moved += '?';
+      ASSERT_EQUAL(37ULL, moved.size());
+
       // Test with String lvalue
       String<> str(cstr);
       Vector<char> buffer4(str, false);
@@ -191,6 +259,127 @@ namespace Concept {
       ASSERT_EQUAL(3, vec[2]);
       ASSERT_EQUAL(2, vec[3]);
     }
+
+    {
+      // Test geometric growth: appending one by one reallocates a logarithmic number of times
+      Vector<int, 8, CountingAllocator<int> > vec;
+      for (int i = 0; i < 10000; ++i) vec.push_back(i);
+
+      ASSERT_EQUAL(10000ULL, vec.size());
+      ASSERT_TRUE(CountingAllocator<int>::allocations < 12);
+      ASSERT_EQUAL(9999, vec[9999]);
+
+      // reserve() allocates the exact size
+      Vector<int> exact;
+      exact.reserve(1000);
+      ASSERT_EQUAL(1000ULL, exact.capacity());
+    }
+    ASSERT_EQUAL(CountingAllocator<int>::allocations, CountingAllocator<int>::deallocations);
+
+    {
+      // Test uninitialized storage: reserving constructs nothing, growing moves, every element is destroyed once
+      Counted::reset();
+      {
+        Vector<Counted> vec;
+        vec.reserve(100);
+        ASSERT_EQUAL(0ULL, Counted::constructions);
+
+        for (int i = 0; i < 1000; ++i) vec.emplace_back(i);
+        ASSERT_EQUAL(1000ULL, Counted::constructions);
+        ASSERT_EQUAL(0ULL, Counted::copies);
+        ASSERT_TRUE(Counted::moves > 0);
+        ASSERT_EQUAL(999, vec[999].value);
+
+        // Moving a heap buffer moves no element
+        size_t moves = Counted::moves;
+        Vector<Counted> moved(std::move(vec));
+        ASSERT_EQUAL(moves, Counted::moves);
+        ASSERT_EQUAL(0ULL, vec.size());
+
+        moved.resize(10);
+        ASSERT_EQUAL(10ULL, moved.size());
+      }
+      ASSERT_EQUAL(Counted::constructions + Counted::copies + Counted::moves, Counted::destructions);
+    }
+
+    {
+      // Test appending elements of the vector itself while it grows
+      Vector<String<> > vec = { String<>("Thailand"), String<>("Which restaurants do East Asian food") };
+      for (int i = 0; i < 20; ++i) vec.push_back(vec[0]);
+      vec += vec;
+
+      ASSERT_EQUAL(44ULL, vec.size());
+      ASSERT_EQUAL(String<>("Thailand"), vec[43]);
+      ASSERT_EQUAL(String<>("Which restaurants do East Asian food"), vec[23]);
+
+      Vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7, 8 };
+      numbers.emplace_back(numbers[0]);
+      ASSERT_EQUAL(1, numbers[8]);
+    }
+
+    {
+      // Test searches: bytes with memchr, other elements with template predicates
+      Vector<char> text = String<>("Which restaurants do East Asian food?");
+      ASSERT_EQUAL(text.begin() + 5, text.find(' '));
+      ASSERT_EQUAL(text.last(), text.find('?'));
+      ASSERT_TRUE(text.end() == text.find('!'));
+      ASSERT_TRUE(!Vector<char>().contains(' '));
+      ASSERT_TRUE(text.contains('e', [](char a, char b) { return (a | 0x20) == b; }));
+      ASSERT_TRUE(text.contains('a', [](char a, char b) { return (a | 0x20) == b; }));
+
+      Vector<int> numbers = { 3, 1, 4, 1, 5 };
+      ASSERT_EQUAL(numbers.begin() + 1, numbers.find(1));
+      ASSERT_EQUAL(numbers.begin() + 2, numbers.find(1, [](int a, int b) { return a == b + 3; }));
+      ASSERT_TRUE(!numbers.contains(9));
+
+      // Equality of floating-point numbers is not bitwise
+      Vector<double> zeros = { 0.0 };
+      Vector<double> negativeZeros = { -0.0 };
+      ASSERT_TRUE(zeros == negativeZeros);
+
+      // Equality of bytes goes through memcmp, also against views
+      ASSERT_TRUE(text == View<char>("Which restaurants do East Asian food?", 37));
+      ASSERT_TRUE(!(text == View<char>("Which restaurants do East Asian food!", 37)));
+      ASSERT_TRUE(View<char>("Thai", 4) == Vector<char>(String<>("Thai")));
+    }
+
+    {
+      // Test the compact layout: the small buffer overlaps the heap pointer, ownership is a capacity bit
+      using CompactVector = Vector<char, 8, std::allocator<char>, uint32_t>;
+      ASSERT_EQUAL(3 * sizeof(void*), sizeof(Vector<char>));
+      ASSERT_EQUAL(sizeof(void*) + 8, sizeof(CompactVector));
+      ASSERT_EQUAL(0x7FFFFFFFULL, CompactVector::max_size());
+
+      const char* cstr = "Which restaurants do East Asian food";
+      CompactVector overlay(cstr, 36, false);
+      CompactVector copy(overlay);
+      ASSERT_EQUAL(cstr, copy.data());
+      ASSERT_EQUAL(36ULL, copy.capacity());
+
+      // An owned copy of an owned vector
+      CompactVector owned(cstr, 36);
+      owned += overlay;
+      ASSERT_EQUAL(72ULL, owned.size());
+      ASSERT_TRUE(owned.data() != cstr);
+      ASSERT_TRUE(View<char>(cstr, 36) == CompactVector(owned.data() + 36, 36, false));
+
+      // Overlays cannot grow
+      overlay.push_back('?');
+      ASSERT_EQUAL(36ULL, overlay.size());
+
+      Vector<uint8_t, 8, std::allocator<uint8_t>, uint8_t> tiny;
+      for (int i = 0; i < 127; ++i) tiny.push_back(static_cast<uint8_t>(i));
+      ASSERT_EQUAL(126, tiny[126]);
+
+      bool thrown = false;
+      try {
+        tiny.push_back(127);
+      } catch (const std::length_error&) {
+        thrown = true;
+      }
+      ASSERT_TRUE(thrown);
+      ASSERT_EQUAL(127ULL, tiny.size());
+    }
   }
 
 } //end namespace Concept
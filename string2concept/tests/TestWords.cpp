@@ -31,6 +31,7 @@
 
 #include "stdafx.h"
 
+#include <string>
 #include "../core/Vector.hpp"
 #include "../Words.hpp"
 #include "TestWords.hpp"
@@ -59,6 +60,12 @@ namespace Concept {
         auto substr = words.get(words.begin() + 3, 2);
         ASSERT_EQUAL(Vector<char>("East Asian", 10), substr);
         ASSERT_EQUAL(size_t(cstr + 21), size_t(substr.data()));
+
+        // View the same words
+        auto view = words.view(words.begin() + 3, 2);
+        ASSERT_TRUE(view == substr);
+        ASSERT_EQUAL(size_t(cstr + 21), size_t(view.data()));
+        ASSERT_EQUAL(0UL, words.view(words.begin() + 5, 2).size());
       }
 
       {
@@ -70,9 +77,68 @@ namespace Concept {
         ASSERT_EQUAL(6UL, words.length());
         auto substr = words.get(words.begin() + 3, 2);
         ASSERT_EQUAL(Vector<char>("East Asian", 10), substr);
+
+        // Copied words are packed, separated by single spaces
+        ASSERT_TRUE(words.view(words.begin() + 3, 2) == substr);
+        ASSERT_TRUE(words.view(words.begin() + 3, 1) == Vector<char>("East", 4));
+        ASSERT_TRUE(words.data() != substr.data());
       }
 
       ASSERT_EQUAL(6UL, Words(Vector<char>(String<>(" Where can   I find good sushi "))).length());
+
+      {
+        // Words are columns of offsets and lengths. Copies are packed with single spaces
+        Vector<char> text(String<>(" Where can   I find good sushi "));
+        Words overlay(text, false);
+        ASSERT_EQUAL(13UL, overlay.offset(2));
+        ASSERT_EQUAL(4UL, overlay.wordLength(3));
+        ASSERT_TRUE(overlay.word(5) == Vector<char>("sushi", 5));
+        ASSERT_TRUE(overlay.view(1, 2) == Vector<char>("can   I", 7));
+
+        Words copy(text);
+        ASSERT_EQUAL(10UL, copy.offset(2));
+        ASSERT_TRUE(copy.view(0, 6) == Vector<char>("Where can I find good sushi", 27));
+
+        // Moved words keep their packed buffer
+        Words moved(std::move(copy));
+        ASSERT_TRUE(moved.get(1, 2) == Vector<char>("can I", 5));
+        ASSERT_TRUE(moved.word(0) == Vector<char>("Where", 5));
+
+        // Iterators view the words
+        size_t count = 0;
+        for (auto& word : overlay) count += word.size();
+        ASSERT_EQUAL(22UL, count);
+        ASSERT_EQUAL(4L, (overlay.end() - 2) - overlay.begin());
+        ASSERT_TRUE(*(overlay.begin() + 4) == Vector<char>("good", 4));
+      }
+
+      {
+        // Fill the hash column while overlaying delimited words
+        Vector<char> text(String<>("east asian food"));
+        Vector<uint32_t> boundaries = { 0, 4, 5, 10, 11, 15 };
+        Words words(text, boundaries, [](const char* word, size_t len) { return len * 31 + word[0]; });
+        ASSERT_EQUAL(3UL, words.length());
+        ASSERT_TRUE(words.hashed());
+        ASSERT_EQUAL(size_t(5 * 31 + 'a'), words.hash(1));
+        ASSERT_TRUE(!Words(text, boundaries).hashed());
+      }
+
+      {
+        // Words longer than the 16-bit length column
+        std::string chars(200000, 'a');
+        chars[70000] = ' ';
+        chars[70001] = ' ';
+        chars[70003] = ' ';
+        Vector<char> text(chars.data(), chars.size());
+
+        Words words(text, false);
+        ASSERT_EQUAL(3UL, words.length());
+        ASSERT_EQUAL(70000UL, words.wordLength(0));
+        ASSERT_EQUAL(1UL, words.wordLength(1));
+        ASSERT_EQUAL(129996UL, words.wordLength(2));
+        ASSERT_EQUAL(200000UL, words.view(0, 3).size());
+        ASSERT_EQUAL(200000UL - 1, Words(text).view(0, 3).size());
+      }
   }
 
 } //end namespace Concept